@@ -3,8 +3,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/path_service.h"
 #include "base/scoped_observer.h"
+#include "base/test/bind.h"
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -72,6 +77,47 @@ std::unique_ptr<net::test_server::HttpResponse> HandleRequestServerError(
   return std::move(http_response);
 }
 
+// Fake node which answers batches and counts the HTTP requests it gets.
+std::unique_ptr<net::test_server::HttpResponse> HandleBatchRequest(
+    std::atomic<int>* request_count,
+    const net::test_server::HttpRequest& request) {
+  ++*request_count;
+  auto respond = [](const base::Value& call) {
+    base::Value response(base::Value::Type::DICTIONARY);
+    response.SetStringKey("jsonrpc", "2.0");
+    if (const base::Value* id = call.FindKey("id"))
+      response.SetKey("id", id->Clone());
+    const std::string* method = call.FindStringKey("method");
+    if (method && *method == "eth_call") {
+      response.SetStringKey("result",
+                            "0x00000000000000000000000000000000000000000000000"
+                            "166e12cfce39a0000");
+    } else {
+      response.SetStringKey("result", "0xb539d5");
+    }
+    return response;
+  };
+
+  std::string content;
+  base::Optional<base::Value> calls = base::JSONReader::Read(request.content);
+  if (calls && calls->is_list()) {
+    base::Value responses(base::Value::Type::LIST);
+    // Answer in reverse order, which JSON-RPC allows.
+    const auto& list = calls->GetList();
+    for (size_t i = list.size(); i > 0; --i)
+      responses.Append(respond(list[i - 1]));
+    base::JSONWriter::Write(responses, &content);
+  } else if (calls && calls->is_dict()) {
+    base::JSONWriter::Write(respond(*calls), &content);
+  }
+
+  auto http_response = std::make_unique<net::test_server::BasicHttpResponse>();
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("application/json");
+  http_response->set_content(content);
+  return std::move(http_response);
+}
+
 }  // namespace
 
 class EthJsonRpcBrowserTest : public InProcessBrowserTest {
@@ -286,3 +332,83 @@ IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
 
   WaitForResponse("", false);
 }
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest, BatchesAndCachesReads) {
+  std::atomic<int> request_count(0);
+  ResetHTTPSServer(base::BindRepeating(&HandleBatchRequest, &request_count));
+  auto* rpc_controller = GetEthJsonRpcController();
+
+  int pending = 0;
+  base::RunLoop run_loop;
+  auto expect_balance = [&](const std::string& expected) {
+    ++pending;
+    return base::BindLambdaForTesting(
+        [&, expected](bool success, const std::string& balance) {
+          EXPECT_TRUE(success);
+          EXPECT_EQ(expected, balance);
+          if (--pending == 0)
+            run_loop.Quit();
+        });
+  };
+
+  const std::string token_balance =
+      "0x00000000000000000000000000000000000000000000000166e12cfce39a0000";
+  // Two different reads plus a duplicate go out as one batch.
+  rpc_controller->GetBalance("0x4e02f254184E904300e0775E4b8eeCB1",
+                             expect_balance("0xb539d5"));
+  rpc_controller->GetBalance("0x4e02f254184E904300e0775E4b8eeCB1",
+                             expect_balance("0xb539d5"));
+  EXPECT_TRUE(rpc_controller->GetERC20TokenBalance(
+      "0x0d8775f648430679a709e98d2b0cb6250d2887ef",
+      "0x4e02f254184E904300e0775E4b8eeCB1", expect_balance(token_balance)));
+  run_loop.Run();
+  EXPECT_EQ(1, request_count);
+
+  // Answered from the cache without reaching the node.
+  base::RunLoop cached_run_loop;
+  rpc_controller->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindLambdaForTesting(
+          [&](bool success, const std::string& balance) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ("0xb539d5", balance);
+            cached_run_loop.Quit();
+          }));
+  cached_run_loop.Run();
+  EXPECT_EQ(1, request_count);
+}
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
+                       UnstoppableDomainsResolutionIsCached) {
+  ResetHTTPSServer(base::BindRepeating(&HandleUnstoppableDomainsRequest));
+  auto* rpc_controller = GetEthJsonRpcController();
+  const std::vector<std::string> keys = {
+      "dweb.ipfs.hash", "ipfs.html.value", "browser.redirect_url",
+      "ipfs.redirect_domain.value"};
+  const std::string contract_address =
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5";
+
+  std::string result;
+  EXPECT_FALSE(rpc_controller->GetCachedUnstoppableDomainsProxyReaderGetMany(
+      contract_address, "brave.crypto", keys, &result));
+
+  base::RunLoop run_loop;
+  std::string fetched;
+  rpc_controller->UnstoppableDomainsProxyReaderGetMany(
+      contract_address, "brave.crypto", keys,
+      base::BindLambdaForTesting([&](bool success, const std::string& value) {
+        EXPECT_TRUE(success);
+        fetched = value;
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+
+  EXPECT_TRUE(rpc_controller->GetCachedUnstoppableDomainsProxyReaderGetMany(
+      contract_address, "brave.crypto", keys, &result));
+  EXPECT_EQ(fetched, result);
+
+  // Switching networks drops cached answers.
+  ResetHTTPSServer(base::BindRepeating(&HandleUnstoppableDomainsRequest));
+  EXPECT_FALSE(rpc_controller->GetCachedUnstoppableDomainsProxyReaderGetMany(
+      contract_address, "brave.crypto", keys, &result));
+}
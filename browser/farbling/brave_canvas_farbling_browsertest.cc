@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "base/path_service.h"
+#include "brave/browser/brave_content_browser_client.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/common/chrome_content_client.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+
+using brave_shields::ControlType;
+
+namespace {
+
+const char kEmbeddedTestServerDirectory[] = "canvas";
+const char kTitleScript[] = "domAutomationController.send(document.title);";
+
+}  // namespace
+
+class BraveCanvasFarblingBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    content_client_.reset(new ChromeContentClient);
+    content::SetContentClient(content_client_.get());
+    browser_content_client_.reset(new BraveContentBrowserClient());
+    content::SetBrowserClientForTesting(browser_content_client_.get());
+
+    host_resolver()->AddRule("*", "127.0.0.1");
+    content::SetupCrossSiteRedirector(embedded_test_server());
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    test_data_dir = test_data_dir.AppendASCII(kEmbeddedTestServerDirectory);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  void TearDown() override {
+    browser_content_client_.reset();
+    content_client_.reset();
+  }
+
+  HostContentSettingsMap* content_settings() {
+    return HostContentSettingsMapFactory::GetForProfile(browser()->profile());
+  }
+
+  std::string ExecScriptGetStr(const std::string& script) {
+    std::string value;
+    EXPECT_TRUE(ExecuteScriptAndExtractString(contents(), script, &value));
+    return value;
+  }
+
+  content::WebContents* contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  bool NavigateToURLUntilLoadStop(const GURL& url) {
+    ui_test_utils::NavigateToURL(browser(), url);
+    return WaitForLoadStop(contents());
+  }
+
+ private:
+  std::unique_ptr<ChromeContentClient> content_client_;
+  std::unique_ptr<BraveContentBrowserClient> browser_content_client_;
+};
+
+// Reads back a 4K canvas 100 times. Farbled readbacks of unchanged content
+// must stay identical.
+IN_PROC_BROWSER_TEST_F(BraveCanvasFarblingBrowserTest,
+                       RepeatedGetImageDataIsStable) {
+  GURL url =
+      embedded_test_server()->GetURL("a.com", "/getimagedata-readback.html");
+
+  for (auto control_type :
+       {ControlType::ALLOW, ControlType::DEFAULT, ControlType::BLOCK}) {
+    brave_shields::SetFingerprintingControlType(content_settings(),
+                                                control_type, url);
+    NavigateToURLUntilLoadStop(url);
+    EXPECT_EQ(ExecScriptGetStr(kTitleScript), "pass");
+  }
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+IN_PROC_BROWSER_TEST_F(BraveCanvasFarblingBrowserTest,
+                       DISABLED_BenchmarkRepeatedGetImageData) {
+  GURL url =
+      embedded_test_server()->GetURL("a.com", "/getimagedata-readback.html");
+
+  for (auto control_type :
+       {ControlType::ALLOW, ControlType::DEFAULT, ControlType::BLOCK}) {
+    brave_shields::SetFingerprintingControlType(content_settings(),
+                                                control_type, url);
+    NavigateToURLUntilLoadStop(url);
+    ASSERT_EQ(ExecScriptGetStr(kTitleScript), "pass");
+
+    std::string readback_time = ExecScriptGetStr(
+        "domAutomationController.send(readbackTime.toFixed(1));");
+    LOG(INFO) << "100 readbacks of a 4K canvas with fingerprinting control "
+              << brave_shields::ControlTypeToString(control_type) << " took "
+              << readback_time << "ms";
+  }
+}
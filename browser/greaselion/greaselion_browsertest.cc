@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <map>
+
 #include "base/containers/flat_map.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -21,6 +23,7 @@
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
 #include "net/dns/mock_host_resolver.h"
@@ -341,6 +344,42 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjectionWithPrecondition) {
   EXPECT_EQ(title, "Altered");
 }
 
+// Toggling a feature should only install or uninstall the rules that depend
+// on it and leave every other Greaselion extension loaded as it was.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       FeatureToggleOnlyUpdatesAffectedRules) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+  std::map<extensions::ExtensionId, const extensions::Extension*> loaded;
+  for (const auto& id : greaselion_service->GetExtensionIdsForTesting()) {
+    loaded[id] = registry->enabled_extensions().GetByID(id);
+    ASSERT_TRUE(loaded[id]);
+  }
+  ASSERT_FALSE(loaded.empty());
+
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(greaselion_service->GetExtensionIdsForTesting().size(),
+            loaded.size() + 1);
+  for (const auto& extension : loaded) {
+    EXPECT_EQ(registry->enabled_extensions().GetByID(extension.first),
+              extension.second);
+  }
+
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, false);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(greaselion_service->GetExtensionIdsForTesting().size(),
+            loaded.size());
+  for (const auto& extension : loaded) {
+    EXPECT_EQ(registry->enabled_extensions().GetByID(extension.first),
+              extension.second);
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsGreaselionExtension) {
   ASSERT_TRUE(InstallMockExtension());
 
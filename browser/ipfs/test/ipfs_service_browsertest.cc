@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
 #include "base/base64.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -17,6 +19,7 @@
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_service.h"
+#include "brave/components/ipfs/ipfs_service_observer.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "brave/components/ipfs/pref_names.h"
 #include "chrome/browser/profiles/profile.h"
@@ -1101,4 +1104,137 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, UpdaterRegistration) {
   }
 }
 
+class IpfsParallelFolderImportBrowserTest : public IpfsServiceBrowserTest,
+                                            public IpfsServiceObserver {
+ public:
+  IpfsParallelFolderImportBrowserTest() {
+    feature_list_.InitAndEnableFeature(
+        ipfs::features::kIpfsParallelFolderImport);
+  }
+
+  void SetUpOnMainThread() override {
+    IpfsServiceBrowserTest::SetUpOnMainThread();
+    ipfs_service()->AddObserver(this);
+  }
+
+  void TearDownOnMainThread() override {
+    ipfs_service()->RemoveObserver(this);
+    IpfsServiceBrowserTest::TearDownOnMainThread();
+  }
+
+  // Fakes the local daemon api used by the parallel folder import.
+  std::unique_ptr<net::test_server::HttpResponse> HandleFolderImportRequests(
+      bool fail_add,
+      const net::test_server::HttpRequest& request) {
+    const GURL gurl = request.GetURL();
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_content_type("application/json");
+    if (gurl.path_piece() == kImportAddPath) {
+      add_requests_++;
+      if (fail_add) {
+        http_response->set_code(net::HTTP_INTERNAL_SERVER_ERROR);
+        return http_response;
+      }
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content(
+          "{\"Name\":\"file\", \"Size\":\"10\", \"Hash\": \"QmFile\"}\n");
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportMakeDirectoryPath) {
+      mkdir_requests_++;
+      http_response->set_code(net::HTTP_OK);
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportCopyPath) {
+      copy_requests_++;
+      http_response->set_code(net::HTTP_OK);
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportStatPath) {
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content(
+          R"({"Hash":"QmFolder","Size":0,"CumulativeSize":123,)"
+          R"("Type":"directory"})");
+      return http_response;
+    }
+    if (gurl.path_piece() == kAPIPublishNameEndpoint) {
+      http_response->set_code(net::HTTP_OK);
+      return http_response;
+    }
+    return nullptr;
+  }
+
+  // IpfsServiceObserver
+  void OnImportProgress(const base::FilePath& path,
+                        int64_t uploaded_bytes,
+                        int64_t total_bytes) override {
+    EXPECT_LE(uploaded_bytes, total_bytes);
+    last_uploaded_bytes_ = uploaded_bytes;
+    last_total_bytes_ = total_bytes;
+  }
+
+  base::FilePath GetTestFolder() {
+    auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+    return embedded_test_server()->GetFullPathFromSourceDirectory(
+        base::FilePath(folder));
+  }
+
+ protected:
+  std::atomic<int> add_requests_{0};
+  std::atomic<int> mkdir_requests_{0};
+  std::atomic<int> copy_requests_{0};
+  int64_t last_uploaded_bytes_ = -1;
+  int64_t last_total_bytes_ = -1;
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(IpfsParallelFolderImportBrowserTest,
+                       ImportDirectoryToIpfsSuccess) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsParallelFolderImportBrowserTest::HandleFolderImportRequests,
+      base::Unretained(this), false));
+  ipfs_service()->ImportDirectoryToIpfs(
+      GetTestFolder(), std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedSuccess,
+                     base::Unretained(this)));
+  WaitForRequest();
+  // manifest.json and 1/AutoplayWhitelist.dat.
+  EXPECT_EQ(add_requests_, 2);
+  // The folder root and 1/.
+  EXPECT_EQ(mkdir_requests_, 2);
+  EXPECT_EQ(copy_requests_, 2);
+  EXPECT_GT(last_total_bytes_, 0);
+  EXPECT_EQ(last_uploaded_bytes_, last_total_bytes_);
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsParallelFolderImportBrowserTest,
+                       ImportAndPinDirectorySuccess) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsParallelFolderImportBrowserTest::HandleFolderImportRequests,
+      base::Unretained(this), false));
+  ipfs_service()->ImportDirectoryToIpfs(
+      GetTestFolder(), std::string("pin"),
+      base::BindOnce(&IpfsServiceBrowserTest::OnPublishCompletedSuccess,
+                     base::Unretained(this)));
+  WaitForRequest();
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsParallelFolderImportBrowserTest,
+                       ImportDirectoryToIpfsAddFail) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsParallelFolderImportBrowserTest::HandleFolderImportRequests,
+      base::Unretained(this), true));
+  ipfs_service()->ImportDirectoryToIpfs(
+      GetTestFolder(), std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedFail,
+                     base::Unretained(this), IPFS_IMPORT_ERROR_ADD_FAILED,
+                     "autoplay-whitelist-data"));
+  WaitForRequest();
+  EXPECT_EQ(mkdir_requests_, 0);
+  EXPECT_EQ(copy_requests_, 0);
+}
+
 }  // namespace ipfs
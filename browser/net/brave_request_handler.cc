@@ -210,7 +210,7 @@ int BraveRequestHandler::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
-  if (!ctx->tab_origin.is_empty()) {
+  if (!ctx->tab_origin.is_empty() && ctx->IsThirdPartyToTab()) {
     brave::RemoveTrackableSecurityHeadersForThirdParty(
         ctx->request_url, url::Origin::Create(ctx->tab_origin),
         original_response_headers, override_response_headers);
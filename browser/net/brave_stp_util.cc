@@ -6,7 +6,7 @@
 #include "brave/browser/net/brave_stp_util.h"
 
 #include "base/no_destructor.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "brave/components/brave_shields/browser/registrable_domain_cache.h"
 
 namespace brave {
 
@@ -26,9 +26,8 @@ void RemoveTrackableSecurityHeadersForThirdParty(
     return;
   }
 
-  if (net::registry_controlled_domains::SameDomainOrHost(
-          request_url, top_frame_origin,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+  if (!brave_shields::IsThirdPartyHost(request_url.host_piece(),
+                                       top_frame_origin.host())) {
     return;
   }
 
@@ -5,6 +5,7 @@
 
 #include "brave/browser/net/decentralized_dns_network_delegate_helper.h"
 
+#include <string>
 #include <vector>
 
 #include "net/base/net_errors.h"
@@ -45,10 +46,20 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
       return net::OK;
     }
 
+    const std::vector<std::string> keys(std::begin(kRecordKeys),
+                                        std::end(kRecordKeys));
+    std::string result;
+    if (service->rpc_controller()
+            ->GetCachedUnstoppableDomainsProxyReaderGetMany(
+                kProxyReaderContractAddress, ctx->request_url.host(), keys,
+                &result)) {
+      OnBeforeURLRequest_DecentralizedDnsRedirectWork(brave::ResponseCallback(),
+                                                      ctx, true, result);
+      return net::OK;
+    }
+
     service->rpc_controller()->UnstoppableDomainsProxyReaderGetMany(
-        kProxyReaderContractAddress, ctx->request_url.host(),
-        std::vector<std::string>(std::begin(kRecordKeys),
-                                 std::end(kRecordKeys)),
+        kProxyReaderContractAddress, ctx->request_url.host(), keys,
         base::BindOnce(&OnBeforeURLRequest_DecentralizedDnsRedirectWork,
                        next_callback, ctx));
 
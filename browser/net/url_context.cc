@@ -10,6 +10,7 @@
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/registrable_domain_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
@@ -55,6 +56,22 @@ BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
 BraveRequestInfo::~BraveRequestInfo() = default;
 
+bool BraveRequestInfo::IsThirdPartyToInitiator() const {
+  if (!is_third_party_to_initiator_) {
+    is_third_party_to_initiator_ = brave_shields::IsThirdPartyHost(
+        request_url.host_piece(), initiator_url.host_piece());
+  }
+  return *is_third_party_to_initiator_;
+}
+
+bool BraveRequestInfo::IsThirdPartyToTab() const {
+  if (!is_third_party_to_tab_) {
+    is_third_party_to_tab_ = brave_shields::IsThirdPartyHost(
+        request_url.host_piece(), tab_origin.host_piece());
+  }
+  return *is_third_party_to_tab_;
+}
+
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
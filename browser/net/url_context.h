@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/optional.h"
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -101,6 +102,12 @@ struct BraveRequestInfo {
 
   bool ShouldMockRequest() const { return !mock_data_url.empty(); }
 
+  // Whether |request_url| is third-party to |initiator_url| or |tab_origin|.
+  // Looked up at most once per request, through the registrable domain cache
+  // shared by all shields checks.
+  bool IsThirdPartyToInitiator() const;
+  bool IsThirdPartyToTab() const;
+
   net::NetworkIsolationKey network_isolation_key = net::NetworkIsolationKey();
 
   // Default to invalid type for resource_type, so delegate helpers
@@ -128,6 +135,9 @@ struct BraveRequestInfo {
 
   GURL* new_url = nullptr;
 
+  mutable base::Optional<bool> is_third_party_to_initiator_;
+  mutable base::Optional<bool> is_third_party_to_tab_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
@@ -57,7 +57,9 @@ constexpr char kDailyUptimesListPrefName[] = "daily_uptimes";
 }  // namespace
 
 BraveUptimeTracker::BraveUptimeTracker(PrefService* local_state)
-    : state_(local_state, kDailyUptimesListPrefName) {
+    : state_(local_state,
+             kDailyUptimesListPrefName,
+             WeeklyStorage::WriteMode::kDeferred) {
   timer_.Start(FROM_HERE,
                base::TimeDelta::FromMinutes(kUsageTimeQueryIntervalMinutes),
                base::BindRepeating(&BraveUptimeTracker::RecordUsage,
@@ -98,6 +100,12 @@ void BraveUptimeTracker::CreateInstance(PrefService* local_state) {
   g_brave_uptime_tracker_instance = new BraveUptimeTracker(local_state);
 }
 
+void BraveUptimeTracker::FlushInstance() {
+  if (g_brave_uptime_tracker_instance) {
+    g_brave_uptime_tracker_instance->state_.Flush();
+  }
+}
+
 void BraveUptimeTracker::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterListPref(kDailyUptimesListPrefName);
 }
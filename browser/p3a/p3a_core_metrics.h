@@ -36,6 +36,10 @@ class BraveUptimeTracker {
 
   static void CreateInstance(PrefService* local_state);
 
+  // Writes the buffered uptime of the leaked instance to prefs. Called on
+  // shutdown, before local state is committed.
+  static void FlushInstance();
+
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
  private:
@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
@@ -22,6 +23,17 @@ BraveWalletService* GetBraveWalletService(content::BrowserContext* context) {
   return BraveWalletServiceFactory::GetInstance()->GetForContext(context);
 }
 
+// |keyring_controller| runs this callback, so it is alive here.
+void OnDefaultKeyringCreated(
+    brave_wallet::KeyringController* keyring_controller,
+    wallet_ui::mojom::PageHandler::CreateWalletCallback callback,
+    brave_wallet::HDKeyring* keyring) {
+  if (keyring) {
+    keyring->AddAccounts();
+  }
+  std::move(callback).Run(keyring_controller->GetMnemonicForDefaultKeyring());
+}
+
 }  // namespace
 
 WalletPageHandler::WalletPageHandler(
@@ -42,11 +54,11 @@ void WalletPageHandler::CreateWallet(const std::string& password,
   auto* browser_context = web_ui_->GetWebContents()->GetBrowserContext();
   auto* keyring_controller =
       GetBraveWalletService(browser_context)->keyring_controller();
-  auto* keyring = keyring_controller->CreateDefaultKeyring(password);
-  if (keyring) {
-    keyring->AddAccounts();
-  }
-  std::move(callback).Run(keyring_controller->GetMnemonicForDefaultKeyring());
+  keyring_controller->CreateDefaultKeyring(
+      password,
+      base::BindOnce(&OnDefaultKeyringCreated,
+                     base::Unretained(keyring_controller),
+                     std::move(callback)));
 }
 
 void WalletPageHandler::OnVisibilityChanged(content::Visibility visibility) {
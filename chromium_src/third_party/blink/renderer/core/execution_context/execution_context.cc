@@ -6,6 +6,7 @@
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 
 #include "base/command_line.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
@@ -14,6 +15,7 @@
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/workers/worker_global_scope.h"
+#include "third_party/blink/renderer/platform/audio/vector_math.h"
 #include "third_party/blink/renderer/platform/bindings/script_state.h"
 #include "third_party/blink/renderer/platform/graphics/image_data_buffer.h"
 #include "third_party/blink/renderer/platform/graphics/static_bitmap_image.h"
@@ -22,6 +24,7 @@
 #include "third_party/blink/renderer/platform/network/network_utils.h"
 #include "third_party/blink/renderer/platform/supplementable.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/boringssl/src/include/openssl/siphash.h"
 
 namespace {
 
@@ -31,26 +34,11 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
+// Returns a pseudo-random float between 0 and 0.1.
+inline float NextPseudoRandomSample(uint64_t* v) {
   const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
+  *v = lfsr_next(*v);
+  return (*v / maxUInt64AsDouble) / 10;
 }
 
 }  // namespace
@@ -67,6 +55,70 @@ const char kLettersForRandomStrings[] =
 // length of kLettersForRandomStrings array
 const size_t kLettersForRandomStringsLength = 64;
 
+AudioFarblingHelper::AudioFarblingHelper() = default;
+AudioFarblingHelper::~AudioFarblingHelper() = default;
+AudioFarblingHelper::AudioFarblingHelper(const AudioFarblingHelper&) = default;
+AudioFarblingHelper& AudioFarblingHelper::operator=(
+    const AudioFarblingHelper&) = default;
+
+// static
+AudioFarblingHelper AudioFarblingHelper::ConstantMultiplier(
+    float fudge_factor) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kConstantMultiplier;
+  helper.fudge_factor_ = fudge_factor;
+  return helper;
+}
+
+// static
+AudioFarblingHelper AudioFarblingHelper::PseudoRandomSequence(uint64_t seed) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kPseudoRandomSequence;
+  helper.seed_ = seed;
+  helper.sequence_state_ = seed;
+  return helper;
+}
+
+void AudioFarblingHelper::FarbleAudioChannel(base::span<float> samples) const {
+  if (samples.empty())
+    return;
+  switch (mode_) {
+    case Mode::kOff:
+      break;
+    case Mode::kConstantMultiplier: {
+      blink::vector_math::Vsmul(samples.data(), 1, &fudge_factor_,
+                                samples.data(), 1,
+                                base::checked_cast<uint32_t>(samples.size()));
+      break;
+    }
+    case Mode::kPseudoRandomSequence: {
+      // Sequence state lives on the stack so concurrent callers, e.g. audio
+      // contexts in workers, don't share it.
+      uint64_t v = seed_;
+      for (float& sample : samples)
+        sample = NextPseudoRandomSample(&v);
+      break;
+    }
+  }
+}
+
+float AudioFarblingHelper::FarbleSample(float value, size_t index) {
+  switch (mode_) {
+    case Mode::kOff:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      // Start of loop, reset to the initial seed which is based on the domain
+      // key.
+      if (index == 0)
+        sequence_state_ = seed_;
+      return NextPseudoRandomSample(&sequence_state_);
+  }
+  NOTREACHED();
+  return value;
+}
+
 blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context) {
   blink::WebContentSettingsClient* settings = nullptr;
@@ -130,7 +182,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarblingHelper BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -143,15 +195,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarblingHelper();
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -187,15 +239,8 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
+  const uint8_t* canvas_key = GetCanvasKey(pixels, size);
+  uint64_t v = *reinterpret_cast<const uint64_t*>(canvas_key);
   uint64_t pixel_index;
   // choose which channel (R, G, or B) to perturb
   uint8_t channel;
@@ -216,6 +261,32 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   }
 }
 
+const uint8_t* BraveSessionCache::GetCanvasKey(const uint8_t* pixels,
+                                               size_t size) {
+  uint64_t session_plus_domain_key =
+      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
+  const uint64_t hash_key[2] = {
+      session_plus_domain_key,
+      *reinterpret_cast<const uint64_t*>(domain_key_ + sizeof(uint64_t))};
+  const uint64_t hash = SIPHASH_24(hash_key, pixels, size);
+  for (const CanvasKeyCacheEntry& entry : canvas_key_cache_) {
+    if (entry.size == size && entry.hash == hash)
+      return entry.canvas_key;
+  }
+
+  CanvasKeyCacheEntry& entry = canvas_key_cache_[canvas_key_cache_next_];
+  canvas_key_cache_next_ =
+      (canvas_key_cache_next_ + 1) % canvas_key_cache_.size();
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
+               sizeof session_plus_domain_key));
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
+               entry.canvas_key, sizeof entry.canvas_key));
+  entry.size = size;
+  entry.hash = hash;
+  return entry.canvas_key;
+}
+
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
                                                     wtf_size_t length) {
   uint8_t key[32];
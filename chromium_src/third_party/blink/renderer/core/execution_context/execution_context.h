@@ -8,9 +8,10 @@
 
 #include "../../../../../../../third_party/blink/renderer/core/execution_context/execution_context.h"
 
+#include <array>
 #include <random>
 
-#include "base/callback.h"
+#include "base/containers/span.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -26,7 +27,37 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Farbles Web Audio sample data. Cheap to copy; a default constructed helper
+// leaves samples untouched.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  AudioFarblingHelper();
+  ~AudioFarblingHelper();
+  AudioFarblingHelper(const AudioFarblingHelper&);
+  AudioFarblingHelper& operator=(const AudioFarblingHelper&);
+
+  static AudioFarblingHelper ConstantMultiplier(float fudge_factor);
+  static AudioFarblingHelper PseudoRandomSequence(uint64_t seed);
+
+  bool IsEnabled() const { return mode_ != Mode::kOff; }
+
+  // Farbles |samples| in place. The pseudo-random sequence restarts from the
+  // seed on every call.
+  void FarbleAudioChannel(base::span<float> samples) const;
+
+  // Farbles the sample at |index| for loops that can't hand over a whole
+  // buffer. Samples must be passed in order; the pseudo-random sequence
+  // restarts when |index| is 0.
+  float FarbleSample(float value, size_t index);
+
+ private:
+  enum class Mode { kOff, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_ = Mode::kOff;
+  float fudge_factor_ = 1.0f;
+  uint64_t seed_ = 0;
+  uint64_t sequence_state_ = 0;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -42,7 +73,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  AudioFarblingHelper GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
@@ -56,7 +87,20 @@ class CORE_EXPORT BraveSessionCache final
   uint64_t session_key_;
   uint8_t domain_key_[32];
 
+  // Canvas keys of recent readbacks. Pages often read back the same canvas
+  // content repeatedly; a SipHash of the pixels, keyed by the session and
+  // domain keys so pages cannot craft collisions, finds the key again without
+  // re-running the HMAC over the whole pixel buffer.
+  struct CanvasKeyCacheEntry {
+    size_t size = 0;
+    uint64_t hash = 0;
+    uint8_t canvas_key[32];
+  };
+  std::array<CanvasKeyCacheEntry, 4> canvas_key_cache_;
+  size_t canvas_key_cache_next_ = 0;
+
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
+  const uint8_t* GetCanvasKey(const uint8_t* pixels, size_t size);
 };
 }  // namespace brave
 
@@ -3,24 +3,29 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB                       \
-  if (audio_farbling_callback_) {                                     \
-    destination[i] = audio_farbling_callback_.Run(destination[i], i); \
+#include "base/containers/span.h"
+
+// Float data is farbled once the whole destination buffer is filled.
+#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB \
+  if (audio_farbling_helper_.IsEnabled()) {     \
+    audio_farbling_helper_.FarbleAudioChannel(  \
+        base::make_span(destination, len));     \
   }
 
-#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                  \
-  if (audio_farbling_callback_) {                                 \
-    scaled_value = audio_farbling_callback_.Run(scaled_value, i); \
+#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                         \
+  if (audio_farbling_helper_.IsEnabled()) {                              \
+    scaled_value = audio_farbling_helper_.FarbleSample(scaled_value, i); \
   }
 
-#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA        \
-  if (audio_farbling_callback_) {                            \
-    destination[i] = audio_farbling_callback_.Run(value, i); \
+#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA \
+  if (audio_farbling_helper_.IsEnabled()) {           \
+    audio_farbling_helper_.FarbleAudioChannel(        \
+        base::make_span(destination, len));           \
   }
 
-#define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA \
-  if (audio_farbling_callback_) {                    \
-    value = audio_farbling_callback_.Run(value, i);  \
+#define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA       \
+  if (audio_farbling_helper_.IsEnabled()) {                \
+    value = audio_farbling_helper_.FarbleSample(value, i); \
   }
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/realtime_analyser.cc"
@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 
+#include "base/check.h"
 #include "base/metrics/histogram_functions.h"
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
@@ -94,16 +96,41 @@ void RegisterP2APrefs(PrefRegistrySimple* registry) {
   }
 }
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name) {
-  std::string pref_path(prefs::kP2AStoragePrefNamePrefix);
-  pref_path.append(name);
-  if (!prefs->FindPreference(pref_path)) {
-    return;
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    PrefService* prefs,
+    P2AWeeklyStorages* storages,
+    const std::string& name) {
+  DCHECK(storages);
+
+  auto iter = storages->find(name);
+  if (iter == storages->end()) {
+    std::string pref_path(prefs::kP2AStoragePrefNamePrefix);
+    pref_path.append(name);
+    const PrefService::Preference* pref = prefs->FindPreference(pref_path);
+    if (!pref) {
+      return;
+    }
+
+    // WeeklyStorage keeps the pref name pointer, so use the name owned by the
+    // registered preference rather than the local string
+    iter = storages
+               ->emplace(name, std::make_unique<WeeklyStorage>(
+                                   prefs, pref->name().c_str(),
+                                   WeeklyStorage::WriteMode::kDeferred))
+               .first;
+  }
+
+  WeeklyStorage* storage = iter->second.get();
+  storage->AddDelta(1);
+  EmitP2AHistogramAnswer(name, storage->GetWeeklySum());
+}
+
+void FlushP2AWeeklyStorages(P2AWeeklyStorages* storages) {
+  DCHECK(storages);
+
+  for (auto& storage : *storages) {
+    storage.second->Flush();
   }
-  WeeklyStorage storage(prefs, pref_path.c_str());
-  storage.AddDelta(1);
-  EmitP2AHistogramAnswer(name, storage.GetWeeklySum());
 }
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value) {
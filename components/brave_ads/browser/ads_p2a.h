@@ -8,18 +8,30 @@
 
 #include <cstdint>
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class PrefService;
 class PrefRegistrySimple;
+class WeeklyStorage;
 
 namespace brave_ads {
 
 void RegisterP2APrefs(PrefRegistrySimple* prefs);
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name);
+// Weekly storages for P2A questions, keyed by question name.
+using P2AWeeklyStorages = std::map<std::string, std::unique_ptr<WeeklyStorage>>;
+
+// |storages| must outlive the recording and is the only user of the P2A prefs
+// of |prefs|, so its storages can defer their pref writes.
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    PrefService* prefs,
+    P2AWeeklyStorages* storages,
+    const std::string& name);
+
+void FlushP2AWeeklyStorages(P2AWeeklyStorages* storages);
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value);
 
@@ -60,6 +60,7 @@
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "build/build_config.h"
 #include "chrome/browser/browser_process.h"
@@ -114,6 +115,23 @@ namespace {
 
 constexpr char kAdNotificationUrlPrefix[] = "https://www.brave.com/ads/?";
 
+// Prefs read by the ads library, mirrored into the bat_ads utility process.
+const char* const kMirroredAdsPrefs[] = {
+    ads::prefs::kEnabled,
+    ads::prefs::kShouldAllowConversionTracking,
+    ads::prefs::kAdsPerHour,
+    ads::prefs::kIdleTimeThreshold,
+    ads::prefs::kShouldAllowAdsSubdivisionTargeting,
+    ads::prefs::kAdsSubdivisionTargetingCode,
+    ads::prefs::kAutoDetectedAdsSubdivisionTargetingCode,
+    ads::prefs::kCatalogId,
+    ads::prefs::kCatalogVersion,
+    ads::prefs::kCatalogPing,
+    ads::prefs::kCatalogLastUpdated,
+    ads::prefs::kEpsilonGreedyBanditArms,
+    ads::prefs::kEpsilonGreedyBanditEligibleSegments,
+    ads::prefs::kHasMigratedConversionState};
+
 static std::map<std::string, int> g_schema_resource_ids = {
     {ads::g_catalog_schema_resource_id, IDR_ADS_CATALOG_SCHEMA}};
 
@@ -563,6 +581,8 @@ void AdsServiceImpl::Shutdown() {
 
   idle_poll_timer_.Stop();
 
+  FlushP2AWeeklyStorages(&p2a_weekly_storages_);
+
   bat_ads_.reset();
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
@@ -655,6 +675,16 @@ void AdsServiceImpl::Initialize() {
       base::BindRepeating(&AdsServiceImpl::OnPrefsChanged,
                           base::Unretained(this)));
 
+  for (const char* path : kMirroredAdsPrefs) {
+    if (profile_pref_change_registrar_.IsObserved(path)) {
+      continue;
+    }
+
+    profile_pref_change_registrar_.Add(
+        path, base::BindRepeating(&AdsServiceImpl::OnPrefsChanged,
+                                  base::Unretained(this)));
+  }
+
   MaybeStart(false);
 }
 
@@ -855,6 +885,10 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const bool success) {
       bat_ads_.BindNewEndpointAndPassReceiver(),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
+  // Sent ahead of |Initialize|, so the ads library starts with a complete
+  // local copy of its prefs.
+  MirrorPrefsToBatAds();
+
   OnWalletUpdated();
 
   const std::string locale = GetLocale();
@@ -1673,6 +1707,8 @@ bool AdsServiceImpl::PrefExists(const std::string& path) const {
 }
 
 void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
+  MirrorPrefToBatAds(pref);
+
   if (pref == ads::prefs::kEnabled) {
     rewards_service_->OnAdsEnabled(IsEnabled());
 
@@ -1698,6 +1734,33 @@ void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
   }
 }
 
+void AdsServiceImpl::MirrorPrefsToBatAds() {
+  for (const char* path : kMirroredAdsPrefs) {
+    MirrorPrefToBatAds(path);
+  }
+}
+
+void AdsServiceImpl::MirrorPrefToBatAds(const std::string& path) {
+  if (!connected()) {
+    return;
+  }
+
+  if (std::find_if(std::begin(kMirroredAdsPrefs), std::end(kMirroredAdsPrefs),
+                   [&path](const char* mirrored_path) {
+                     return path == mirrored_path;
+                   }) == std::end(kMirroredAdsPrefs)) {
+    return;
+  }
+
+  const PrefService::Preference* pref =
+      profile_->GetPrefs()->FindPreference(path);
+  if (!pref) {
+    return;
+  }
+
+  bat_ads_->OnPrefChanged(path, pref->GetValue()->Clone());
+}
+
 bool AdsServiceImpl::connected() {
   return bat_ads_.is_bound() && !g_browser_process->IsShuttingDown();
 }
@@ -1989,8 +2052,8 @@ void AdsServiceImpl::RecordP2AEvent(const std::string& name,
       }
 
       for (auto& item : *list) {
-        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(profile_->GetPrefs(),
-                                                       item.GetString());
+        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+            profile_->GetPrefs(), &p2a_weekly_storages_, item.GetString());
       }
       break;
     }
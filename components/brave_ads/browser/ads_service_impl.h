@@ -23,6 +23,7 @@
 #include "bat/ads/database.h"
 #include "bat/ads/mojom.h"
 #include "bat/ledger/mojom_structs.h"
+#include "brave/components/brave_ads/browser/ads_p2a.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/background_helper.h"
 #include "brave/components/brave_ads/browser/component_updater/resource_component.h"
@@ -302,6 +303,11 @@ class AdsServiceImpl : public AdsService,
   bool PrefExists(const std::string& path) const;
   void OnPrefsChanged(const std::string& pref);
 
+  // Pushes ads prefs to the bat_ads utility process so that it can read them
+  // without sync calls.
+  void MirrorPrefsToBatAds();
+  void MirrorPrefToBatAds(const std::string& path);
+
   std::string GetLocale() const;
 
   std::string LoadDataResourceAndDecompressIfNeeded(const int id) const;
@@ -429,6 +435,8 @@ class AdsServiceImpl : public AdsService,
 
   std::unique_ptr<ads::Database> database_;
 
+  P2AWeeklyStorages p2a_weekly_storages_;
+
   ui::IdleState last_idle_state_;
   int last_idle_time_;
 
@@ -9,8 +9,10 @@
 #include <cmath>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -37,7 +39,22 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
-double LinregPredictVector(const std::array<double, feature_count>& features) {
+int FeatureIndex(base::StringPiece feature_name) {
+  // |feature_sequence| outlives the index, so it can refer to its strings.
+  static const base::NoDestructor<base::flat_map<base::StringPiece, int>>
+      feature_index([] {
+        std::vector<std::pair<base::StringPiece, int>> entries;
+        entries.reserve(feature_count);
+        for (int i = 0; i < feature_count; i++)
+          entries.emplace_back(feature_sequence[i], i);
+        return base::flat_map<base::StringPiece, int>(std::move(entries));
+      }());
+
+  auto it = feature_index->find(feature_name);
+  return it != feature_index->end() ? it->second : -1;
+}
+
+double LinregPredictVector(const FeatureVector& features) {
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
   std::copy(features.begin(), features.begin() + standardise_feat_count,
@@ -66,11 +83,11 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
 }
 
 double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
-  std::array<double, feature_count> feature_vector{};
-  for (unsigned int i = 0; i < feature_count; i++) {
-    auto it = features.find(feature_sequence.at(i));
-    if (it != features.end())
-      feature_vector[i] = it->second;
+  FeatureVector feature_vector{};
+  for (const auto& feature : features) {
+    const int index = FeatureIndex(feature.first);
+    if (index >= 0)
+      feature_vector[index] = feature.second;
   }
   return LinregPredictVector(feature_vector);
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,10 +19,18 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+using FeatureVector = std::array<double, feature_count>;
+
+// Returns the position of |feature_name| in the feature vector expected by
+// the predictor, or -1 if the model doesn't use that feature. Callers
+// accumulating features should resolve positions once and fill a
+// |FeatureVector| directly.
+int FeatureIndex(base::StringPiece feature_name);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
-double LinregPredictVector(const std::array<double, feature_count>& features);
+double LinregPredictVector(const FeatureVector& features);
 
 // Computes prediction based on key-value map of features.
 // It translates the map to a feature vector internally, and
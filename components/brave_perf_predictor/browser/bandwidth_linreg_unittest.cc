@@ -104,4 +104,11 @@ TEST(BraveSavingsPredictorTest, HandesSpecificFeaturemapExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndexMatchesSequence) {
+  for (int i = 0; i < feature_count; i++)
+    EXPECT_EQ(FeatureIndex(feature_sequence.at(i)), i);
+  EXPECT_EQ(FeatureIndex("transfer.total.size"), -1);
+  EXPECT_EQ(FeatureIndex("thirdParties.Not An Entity.blocked"), -1);
+}
+
 }  // namespace brave_perf_predictor
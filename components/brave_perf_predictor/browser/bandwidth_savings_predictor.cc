@@ -5,9 +5,8 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
-#include <iostream>
-
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -15,6 +14,96 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+enum ResourceType {
+  kDocument,
+  kStylesheet,
+  kScript,
+  kImage,
+  kFont,
+  kMedia,
+  kOther,
+  kResourceTypeCount,
+};
+
+constexpr const char* kResourceTypeNames[kResourceTypeCount] = {
+    "document", "stylesheet", "script", "image", "font", "media", "other"};
+
+// Model feature positions, resolved once from the feature names.
+struct FeatureSlots {
+  FeatureSlots()
+      : adblock_requests(FeatureIndex("adblockRequests")),
+        first_meaningful_paint(FeatureIndex("metrics.firstMeaningfulPaint")),
+        dom_content_loaded(FeatureIndex("metrics.observedDomContentLoaded")),
+        first_visual_change(FeatureIndex("metrics.observedFirstVisualChange")),
+        load(FeatureIndex("metrics.observedLoad")),
+        third_party_request_count(
+            FeatureIndex("resources.third-party.requestCount")),
+        third_party_size(FeatureIndex("resources.third-party.size")),
+        total_request_count(FeatureIndex("resources.total.requestCount")),
+        total_size(FeatureIndex("resources.total.size")) {
+    DCHECK_GE(adblock_requests, 0);
+    for (int type = 0; type < kResourceTypeCount; type++) {
+      const std::string prefix =
+          std::string("resources.") + kResourceTypeNames[type];
+      request_count[type] = FeatureIndex(prefix + ".requestCount");
+      size[type] = FeatureIndex(prefix + ".size");
+    }
+  }
+
+  const int adblock_requests;
+  const int first_meaningful_paint;
+  const int dom_content_loaded;
+  const int first_visual_change;
+  const int load;
+  const int third_party_request_count;
+  const int third_party_size;
+  const int total_request_count;
+  const int total_size;
+  int request_count[kResourceTypeCount];
+  int size[kResourceTypeCount];
+};
+
+const FeatureSlots& GetFeatureSlots() {
+  static const base::NoDestructor<FeatureSlots> slots;
+  return *slots;
+}
+
+void SetFeature(FeatureVector* features, int slot, double value) {
+  if (slot >= 0)
+    (*features)[slot] = value;
+}
+
+void AddToFeature(FeatureVector* features, int slot, double value) {
+  if (slot >= 0)
+    (*features)[slot] += value;
+}
+
+ResourceType GetResourceType(network::mojom::RequestDestination destination) {
+  switch (destination) {
+    case network::mojom::RequestDestination::kDocument:
+    case network::mojom::RequestDestination::kIframe:
+      return kDocument;
+    case network::mojom::RequestDestination::kStyle:
+      return kStylesheet;
+    case network::mojom::RequestDestination::kScript:
+      return kScript;
+    case network::mojom::RequestDestination::kImage:
+      return kImage;
+    case network::mojom::RequestDestination::kFont:
+      return kFont;
+    case network::mojom::RequestDestination::kAudio:
+    case network::mojom::RequestDestination::kTrack:
+    case network::mojom::RequestDestination::kVideo:
+      return kMedia;
+    default:
+      return kOther;
+  }
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
     : tp_registry_(registry) {}
@@ -23,36 +112,40 @@ BandwidthSavingsPredictor::~BandwidthSavingsPredictor() = default;
 
 void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
+  const FeatureSlots& slots = GetFeatureSlots();
+
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
-        timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
+    SetFeature(
+        &features_, slots.first_meaningful_paint,
+        timing.paint_timing->first_meaningful_paint.value().InMillisecondsF());
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
-        timing.document_timing->dom_content_loaded_event_start.value()
-            .InMillisecondsF();
+    SetFeature(&features_, slots.dom_content_loaded,
+               timing.document_timing->dom_content_loaded_event_start.value()
+                   .InMillisecondsF());
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
-        timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
+    SetFeature(
+        &features_, slots.first_visual_change,
+        timing.paint_timing->first_contentful_paint.value().InMillisecondsF());
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
-        timing.document_timing->load_event_start.value().InMillisecondsF();
+    SetFeature(
+        &features_, slots.load,
+        timing.document_timing->load_event_start.value().InMillisecondsF());
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  AddToFeature(&features_, GetFeatureSlots().adblock_requests, 1);
 
   if (tp_registry_) {
-    const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    const int tp_slot = tp_registry_->GetThirdPartyFeatureIndex(resource_url);
+    SetFeature(&features_, tp_slot, 1);
   }
 }
 
@@ -67,53 +160,27 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
   }
   main_frame_url_ = main_frame_url;
 
+  const FeatureSlots& slots = GetFeatureSlots();
   const bool is_third_party =
       !net::registry_controlled_domains::SameDomainOrHost(
           main_frame_url, resource_load_info.final_url,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    AddToFeature(&features_, slots.third_party_request_count, 1);
+    AddToFeature(&features_, slots.third_party_size,
+                 resource_load_info.raw_body_bytes);
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
-  switch (resource_load_info.request_destination) {
-    case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
-      break;
-    case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
-      break;
-    case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
-      break;
-    case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
-      break;
-    case network::mojom::RequestDestination::kAudio:
-    case network::mojom::RequestDestination::kTrack:
-    case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
-      break;
-    default:
-      resource_type = "other";
-      break;
-  }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  AddToFeature(&features_, slots.total_request_count, 1);
+  AddToFeature(&features_, slots.total_size, resource_load_info.raw_body_bytes);
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+
+  const ResourceType resource_type =
+      GetResourceType(resource_load_info.request_destination);
+  AddToFeature(&features_, slots.request_count[resource_type], 1);
+  AddToFeature(&features_, slots.size[resource_type],
+               resource_load_info.raw_body_bytes);
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,38 +188,45 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  const int adblock_requests_slot = GetFeatureSlots().adblock_requests;
+  if (adblock_requests_slot < 0 || features_[adblock_requests_slot] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    for (int i = 0; i < feature_count; i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
+double BandwidthSavingsPredictor::GetFeature(
+    const std::string& feature_name) const {
+  const int index = FeatureIndex(feature_name);
+  return index >= 0 ? features_[index] : 0;
+}
+
 }  // namespace brave_perf_predictor
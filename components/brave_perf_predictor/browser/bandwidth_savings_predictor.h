@@ -8,8 +8,8 @@
 
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -62,9 +62,17 @@ class BandwidthSavingsPredictor {
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
                            FeaturiseResourceLoading);
 
+  // Returns the accumulated value of |feature_name|, or 0 if the model
+  // doesn't use it.
+  double GetFeature(const std::string& feature_name) const;
+
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Accumulated directly into the slots expected by the model, so blocked
+  // requests and loaded resources don't build or look up feature names.
+  FeatureVector features_{};
+  // Not a model feature, only used to sanity check the prediction.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
@@ -5,10 +5,9 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <utility>
 
 #include "base/bind.h"
-#include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
@@ -17,6 +16,7 @@
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/grit/brave_components_resources.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -27,11 +27,10 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+NamedThirdPartyRegistry::EntityMappings ParseMappings(
+    const base::StringPiece entities,
+    bool discard_irrelevant) {
+  NamedThirdPartyRegistry::EntityMappings mappings;
 
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
@@ -53,14 +52,19 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const size_t entity_id = mappings.entities.size();
+    mappings.entities.push_back(
+        {*entity_name,
+         FeatureIndex("thirdParties." + *entity_name + ".blocked")});
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
       }
-      const base::StringPiece entity_domain(entity_domain_it.GetString());
+      const std::string& entity_domain = entity_domain_it.GetString();
 
       const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
+          mappings.entity_by_domain.emplace(entity_domain, entity_id);
       if (!inserted.second) {
         VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
       }
@@ -68,25 +72,22 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
+      auto root_entity_entry = mappings.entity_by_root_domain.find(root_domain);
+      if (root_entity_entry != mappings.entity_by_root_domain.end() &&
+          mappings.entities[root_entity_entry->second].name != *entity_name) {
         // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
+        mappings.entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
+        mappings.entity_by_root_domain.emplace(std::move(root_domain),
+                                               entity_id);
       }
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+NamedThirdPartyRegistry::EntityMappings ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -99,56 +100,71 @@ ParseFromResource(int resource_id) {
 
 }  // namespace
 
+NamedThirdPartyRegistry::EntityMappings::EntityMappings() = default;
+NamedThirdPartyRegistry::EntityMappings::~EntityMappings() = default;
+NamedThirdPartyRegistry::EntityMappings::EntityMappings(EntityMappings&&) =
+    default;
+NamedThirdPartyRegistry::EntityMappings&
+NamedThirdPartyRegistry::EntityMappings::operator=(EntityMappings&&) = default;
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
-  // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  // Replace previous mappings
   initialized_ = false;
-
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  mappings_ = ParseMappings(entities, discard_irrelevant);
+  if (mappings_.entity_by_domain.empty() ||
+      mappings_.entity_by_root_domain.empty())
     return false;
 
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+void NamedThirdPartyRegistry::UpdateMappings(EntityMappings entity_mappings) {
+  mappings_ = std::move(entity_mappings);
+  VLOG(2) << "Loaded " << mappings_.entity_by_domain.size()
+          << " mappings by domain and "
+          << mappings_.entity_by_root_domain.size() << " by root domain; size";
   initialized_ = true;
 }
 
-base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
-    const base::StringPiece request_url) const {
+const NamedThirdPartyRegistry::EntityMappings::Entity*
+NamedThirdPartyRegistry::FindEntity(const base::StringPiece request_url) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
-    return base::nullopt;
+    return nullptr;
   }
 
   const GURL url(request_url);
-  if (!url.is_valid())
-    return base::nullopt;
+  if (!url.is_valid() || !url.has_host())
+    return nullptr;
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  auto domain_entry = mappings_.entity_by_domain.find(url.host());
+  if (domain_entry != mappings_.entity_by_domain.end())
+    return &mappings_.entities[domain_entry->second];
 
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
+      url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
-  }
+  auto root_domain_entry = mappings_.entity_by_root_domain.find(root_domain);
+  if (root_domain_entry != mappings_.entity_by_root_domain.end())
+    return &mappings_.entities[root_domain_entry->second];
 
-  return base::nullopt;
+  return nullptr;
+}
+
+base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+    const base::StringPiece request_url) const {
+  const auto* entity = FindEntity(request_url);
+  if (!entity)
+    return base::nullopt;
+  return entity->name;
+}
+
+int NamedThirdPartyRegistry::GetThirdPartyFeatureIndex(
+    const base::StringPiece request_url) const {
+  const auto* entity = FindEntity(request_url);
+  return entity ? entity->feature_index : -1;
 }
 
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
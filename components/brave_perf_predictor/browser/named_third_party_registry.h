@@ -7,9 +7,9 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
 #include <string>
-#include <tuple>
+#include <unordered_map>
+#include <vector>
 
-#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -35,17 +35,36 @@ class NamedThirdPartyRegistry : public KeyedService {
   void InitializeDefault();
   base::Optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
+  // Position of the "thirdParties.<entity>.blocked" feature of the bandwidth
+  // model for the entity owning |request_url|, or -1 if there is none.
+  int GetThirdPartyFeatureIndex(const base::StringPiece request_url) const;
+
+  // Entity names are interned, domains map to indices into |entities|.
+  struct EntityMappings {
+    struct Entity {
+      std::string name;
+      int feature_index = -1;
+    };
+
+    EntityMappings();
+    ~EntityMappings();
+    EntityMappings(EntityMappings&&);
+    EntityMappings& operator=(EntityMappings&&);
+
+    std::vector<Entity> entities;
+    std::unordered_map<std::string, size_t> entity_by_domain;
+    std::unordered_map<std::string, size_t> entity_by_root_domain;
+  };
 
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(EntityMappings entity_mappings);
+  const EntityMappings::Entity* FindEntity(
+      const base::StringPiece request_url) const;
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  EntityMappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
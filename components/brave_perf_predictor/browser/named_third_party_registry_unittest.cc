@@ -8,6 +8,7 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -119,4 +120,15 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, ResolvesThirdPartyFeatureIndexTest) {
+  NamedThirdPartyRegistry extractor;
+  auto dataset = LoadFile();
+  extractor.LoadMappings(dataset, true);
+  EXPECT_EQ(extractor.GetThirdPartyFeatureIndex("https://test.m.facebook.com"),
+            FeatureIndex("thirdParties.Facebook.blocked"));
+  EXPECT_EQ(extractor.GetThirdPartyFeatureIndex("https://google-analytics.com"),
+            FeatureIndex("thirdParties.Google Analytics.blocked"));
+  EXPECT_EQ(extractor.GetThirdPartyFeatureIndex("http://example.com"), -1);
+}
+
 }  // namespace brave_perf_predictor
@@ -277,6 +277,17 @@ std::string GetPrefPath(const std::string& name) {
   return base::StringPrintf("%s.%s", pref_prefix, name.c_str());
 }
 
+// The ledger utility process is sandboxed on Android and cannot open the
+// database itself there.
+bool IsLedgerDatabaseInUtilityProcess() {
+#if defined(OS_ANDROID)
+  return false;
+#else
+  return base::FeatureList::IsEnabled(
+      features::kLedgerDatabaseInUtilityProcessFeature);
+#endif
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -346,6 +357,20 @@ RewardsServiceImpl::~RewardsServiceImpl() {
 }
 
 void RewardsServiceImpl::ConnectionClosed() {
+  // Pending replies are dropped with the connection. The process is gone, so
+  // the database it owned is no longer open either.
+  if (stop_ledger_callback_) {
+    OnStopLedger(std::move(stop_ledger_callback_),
+                 ledger::type::Result::LEDGER_ERROR);
+    return;
+  }
+
+  // Complete reset starts the process again once its files are deleted.
+  if (resetting_rewards_) {
+    Reset();
+    return;
+  }
+
   base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
       FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::StartLedgerProcessIfNecessary,
@@ -449,8 +474,12 @@ void RewardsServiceImpl::StartLedgerProcessIfNecessary() {
     return;
   }
 
-  ledger_database_.reset(
-      ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
+  // When the ledger process owns the database, the browser-hosted database
+  // is not opened as SQLite locks the file exclusively.
+  if (!IsLedgerDatabaseInUtilityProcess()) {
+    ledger_database_.reset(
+        ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
+  }
 
   BLOG(1, "Starting ledger process");
 
@@ -487,6 +516,10 @@ void RewardsServiceImpl::StartLedgerProcessIfNecessary() {
     }
   }
 
+  if (IsLedgerDatabaseInUtilityProcess()) {
+    bat_ledger_service_->SetDatabasePath(publisher_info_db_path_);
+  }
+
   bat_ledger_service_->Create(
       bat_ledger_client_receiver_.BindNewEndpointAndPassRemote(),
       bat_ledger_.BindNewEndpointAndPassReceiver(),
@@ -1383,10 +1416,28 @@ void RewardsServiceImpl::StopLedger(StopLedgerCallback callback) {
     return;
   }
 
-  bat_ledger_->Shutdown(base::BindOnce(
-      &RewardsServiceImpl::OnStopLedger,
-      AsWeakPtr(),
-      std::move(callback)));
+  DCHECK(!stop_ledger_callback_);
+  stop_ledger_callback_ = std::move(callback);
+  bat_ledger_->Shutdown(
+      base::BindOnce(&RewardsServiceImpl::OnLedgerShutdown, AsWeakPtr()));
+}
+
+void RewardsServiceImpl::OnLedgerShutdown(const ledger::type::Result result) {
+  if (!IsLedgerDatabaseInUtilityProcess()) {
+    OnStopLedger(std::move(stop_ledger_callback_), result);
+    return;
+  }
+
+  // SQLite keeps the file locked while the ledger process has it open, so it
+  // can't be deleted or opened again before then.
+  bat_ledger_->CloseDatabase(
+      base::BindOnce(&RewardsServiceImpl::OnLedgerDatabaseClosed, AsWeakPtr(),
+                     result));
+}
+
+void RewardsServiceImpl::OnLedgerDatabaseClosed(
+    const ledger::type::Result result) {
+  OnStopLedger(std::move(stop_ledger_callback_), result);
 }
 
 void RewardsServiceImpl::OnStopLedger(
@@ -3153,6 +3204,7 @@ ledger::type::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
 void RewardsServiceImpl::RunDBTransaction(
     ledger::type::DBTransactionPtr transaction,
     ledger::client::RunDBTransactionCallback callback) {
+  // Not reached when the ledger process owns the database.
   DCHECK(ledger_database_);
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
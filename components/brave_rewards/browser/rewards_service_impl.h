@@ -373,6 +373,10 @@ class RewardsServiceImpl : public RewardsService,
 
   std::string GetExternalWalletType() const;
 
+  void OnLedgerShutdown(const ledger::type::Result result);
+
+  void OnLedgerDatabaseClosed(const ledger::type::Result result);
+
   void OnStopLedger(
       StopLedgerCallback callback,
       const ledger::type::Result result);
@@ -791,6 +795,9 @@ class RewardsServiceImpl : public RewardsService,
   bool reset_states_;
   bool ledger_for_testing_ = false;
   bool resetting_rewards_ = false;
+  // Set while the ledger process is shutting down. Run with an error if the
+  // process exits before replying.
+  StopLedgerCallback stop_ledger_callback_;
   int persist_log_level_ = 0;
 
   GetTestResponseCallback test_response_callback_;
@@ -16,5 +16,9 @@ const base::Feature kBitflyerFeature{"BraveRewardsBitflyer",
 const base::Feature kVerboseLoggingFeature{"BraveRewardsVerboseLogging",
                                            base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kLedgerDatabaseInUtilityProcessFeature{
+    "BraveRewardsLedgerDatabaseInUtilityProcess",
+    base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace brave_rewards
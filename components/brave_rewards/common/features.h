@@ -15,6 +15,7 @@ namespace features {
 
 extern const base::Feature kBitflyerFeature;
 extern const base::Feature kVerboseLoggingFeature;
+extern const base::Feature kLedgerDatabaseInUtilityProcessFeature;
 
 }  // namespace features
 }  // namespace brave_rewards
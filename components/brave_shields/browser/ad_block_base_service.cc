@@ -20,15 +20,13 @@
 #include "base/task/thread_pool.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/registrable_domain_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
 using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
@@ -122,12 +120,7 @@ void AdBlockBaseService::ShouldStartRequest(
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
   // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
+  bool is_third_party = IsThirdPartyHost(url.host_piece(), tab_host);
   ad_block_client_->matches(
       url.spec(), url.host(), tab_host, is_third_party,
       ResourceTypeToString(resource_type), did_match_rule,
@@ -146,12 +139,7 @@ base::Optional<std::string> AdBlockBaseService::GetCspDirectives(
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
   // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
+  bool is_third_party = IsThirdPartyHost(url.host_piece(), tab_host);
   const std::string result = ad_block_client_->getCspDirectives(
       url.spec(), url.host(), tab_host, is_third_party,
       ResourceTypeToString(resource_type));
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/registrable_domain_cache.h"
+
+#include <algorithm>
+
+#include "base/hash/hash.h"
+#include "base/no_destructor.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kShardCount = 16;
+
+}  // namespace
+
+RegistrableDomainCache::Shard::Shard(size_t max_entries)
+    : domains(max_entries) {}
+
+RegistrableDomainCache::Shard::~Shard() = default;
+
+// static
+RegistrableDomainCache* RegistrableDomainCache::GetInstance() {
+  static base::NoDestructor<RegistrableDomainCache> instance;
+  return instance.get();
+}
+
+RegistrableDomainCache::RegistrableDomainCache(size_t max_entries) {
+  const size_t shard_size = std::max<size_t>(1, max_entries / kShardCount);
+  for (size_t i = 0; i < kShardCount; ++i)
+    shards_.push_back(std::make_unique<Shard>(shard_size));
+}
+
+RegistrableDomainCache::~RegistrableDomainCache() = default;
+
+RegistrableDomainCache::Shard& RegistrableDomainCache::GetShard(
+    base::StringPiece host) {
+  return *shards_[base::FastHash(host) % shards_.size()];
+}
+
+std::string RegistrableDomainCache::GetRegistrableDomain(
+    base::StringPiece host) {
+  if (host.empty())
+    return std::string();
+
+  const std::string key(host);
+  Shard& shard = GetShard(host);
+  {
+    base::AutoLock lock(shard.lock);
+    auto it = shard.domains.Get(key);
+    if (it != shard.domains.end())
+      return it->second;
+  }
+
+  // Walk the public suffix list outside of the lock.
+  std::string domain = net::registry_controlled_domains::GetDomainAndRegistry(
+      host, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  base::AutoLock lock(shard.lock);
+  shard.domains.Put(key, domain);
+  return domain;
+}
+
+bool RegistrableDomainCache::IsThirdParty(base::StringPiece host,
+                                          base::StringPiece first_party_host) {
+  if (host.empty() || first_party_host.empty())
+    return true;
+  if (host == first_party_host)
+    return false;
+  const std::string domain = GetRegistrableDomain(host);
+  return domain.empty() || domain != GetRegistrableDomain(first_party_host);
+}
+
+bool IsThirdPartyHost(base::StringPiece host,
+                      base::StringPiece first_party_host) {
+  return RegistrableDomainCache::GetInstance()->IsThirdParty(host,
+                                                             first_party_host);
+}
+
+}  // namespace brave_shields
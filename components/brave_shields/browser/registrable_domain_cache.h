@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REGISTRABLE_DOMAIN_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REGISTRABLE_DOMAIN_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+
+namespace brave_shields {
+
+// Bounded memo of host -> registrable domain (eTLD+1, including private
+// registries), shared by the shields checks which decide whether a request is
+// third-party. Lookups are spread over independently locked shards so that
+// callers on different threads rarely wait on each other. Safe to use from any
+// thread.
+class RegistrableDomainCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 4096;
+
+  static RegistrableDomainCache* GetInstance();
+
+  explicit RegistrableDomainCache(size_t max_entries = kDefaultMaxEntries);
+  ~RegistrableDomainCache();
+
+  RegistrableDomainCache(const RegistrableDomainCache&) = delete;
+  RegistrableDomainCache& operator=(const RegistrableDomainCache&) = delete;
+
+  // Returns the registrable domain of |host|, or an empty string if it has
+  // none (IP addresses, bare public suffixes).
+  std::string GetRegistrableDomain(base::StringPiece host);
+
+  // Same result as !SameDomainOrHost(...INCLUDE_PRIVATE_REGISTRIES) for the
+  // two hosts.
+  bool IsThirdParty(base::StringPiece host, base::StringPiece first_party_host);
+
+ private:
+  struct Shard {
+    explicit Shard(size_t max_entries);
+    ~Shard();
+
+    base::Lock lock;
+    base::HashingMRUCache<std::string, std::string> domains GUARDED_BY(lock);
+  };
+
+  Shard& GetShard(base::StringPiece host);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+// Convenience wrapper around RegistrableDomainCache::GetInstance().
+bool IsThirdPartyHost(base::StringPiece host,
+                      base::StringPiece first_party_host);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REGISTRABLE_DOMAIN_CACHE_H_
@@ -0,0 +1,207 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/registrable_domain_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
+#include "base/timer/elapsed_timer.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Hosts commonly seen on news and shopping pages, as a stand-in for a request
+// trace.
+const char* const kRequestHosts[] = {
+    "www.example.com",
+    "cdn.example.com",
+    "static.example.co.uk",
+    "www.google-analytics.com",
+    "securepubads.g.doubleclick.net",
+    "pagead2.googlesyndication.com",
+    "connect.facebook.net",
+    "platform.twitter.com",
+    "cdn.jsdelivr.net",
+    "ajax.googleapis.com",
+    "fonts.gstatic.com",
+    "fonts.googleapis.com",
+    "s3.amazonaws.com",
+    "d1.cloudfront.net",
+    "user.github.io",
+    "foo.blogspot.com",
+    "bar.appspot.com",
+    "images-na.ssl-images-amazon.com",
+    "m.media-amazon.com",
+    "i.ytimg.com",
+    "www.youtube.com",
+    "sb.scorecardresearch.com",
+    "c.amazon-adsystem.com",
+    "tags.tiqcdn.com",
+    "cdn.taboola.com",
+    "widgets.outbrain.com",
+    "127.0.0.1",
+    "[::1]",
+    "localhost",
+    "co.uk",
+};
+
+std::vector<GURL> GetRequestUrls() {
+  std::vector<GURL> urls;
+  for (const char* host : kRequestHosts)
+    urls.emplace_back(std::string("https://") + host + "/");
+  return urls;
+}
+
+// Returns |count| pairs of indices into |kRequestHosts|, skewed towards the
+// first hosts like a real page load.
+std::vector<std::pair<size_t, size_t>> CreateRequestTrace(const int count) {
+  constexpr size_t kHostCount = base::size(kRequestHosts);
+  std::vector<std::pair<size_t, size_t>> trace;
+  trace.reserve(count);
+  uint32_t state = 1;
+  for (int i = 0; i < count; ++i) {
+    state = state * 1103515245 + 12345;
+    const size_t a = (state >> 8) % kHostCount;
+    trace.emplace_back((state >> 16) % (a + 1), i % 4);
+  }
+  return trace;
+}
+
+bool IsThirdPartyUncached(const std::string& host,
+                          const std::string& first_party_host) {
+  return !net::registry_controlled_domains::SameDomainOrHost(
+      GURL("https://" + host + "/"), GURL("https://" + first_party_host + "/"),
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+}
+
+class LookupThread : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit LookupThread(RegistrableDomainCache* cache) : cache_(cache) {}
+
+  void Run() override {
+    for (int i = 0; i < 10000; ++i) {
+      const std::string host = base::StringPrintf("a%d.site%d.com", i, i % 97);
+      EXPECT_EQ(base::StringPrintf("site%d.com", i % 97),
+                cache_->GetRegistrableDomain(host));
+    }
+  }
+
+ private:
+  RegistrableDomainCache* cache_;
+};
+
+}  // namespace
+
+TEST(RegistrableDomainCacheTest, GetRegistrableDomain) {
+  RegistrableDomainCache cache;
+  EXPECT_EQ("example.com", cache.GetRegistrableDomain("www.example.com"));
+  EXPECT_EQ("example.co.uk", cache.GetRegistrableDomain("a.b.example.co.uk"));
+  // Private registries count.
+  EXPECT_EQ("user.github.io", cache.GetRegistrableDomain("user.github.io"));
+  EXPECT_EQ("", cache.GetRegistrableDomain("127.0.0.1"));
+  EXPECT_EQ("", cache.GetRegistrableDomain("co.uk"));
+  EXPECT_EQ("", cache.GetRegistrableDomain(""));
+  // Cached answers are the same.
+  EXPECT_EQ("example.com", cache.GetRegistrableDomain("www.example.com"));
+}
+
+TEST(RegistrableDomainCacheTest, MatchesSameDomainOrHost) {
+  RegistrableDomainCache cache;
+  for (const char* host : kRequestHosts) {
+    for (const char* first_party_host : kRequestHosts) {
+      EXPECT_EQ(IsThirdPartyUncached(host, first_party_host),
+                cache.IsThirdParty(host, first_party_host))
+          << host << " on " << first_party_host;
+    }
+  }
+  EXPECT_TRUE(cache.IsThirdParty("www.example.com", ""));
+  EXPECT_TRUE(cache.IsThirdParty("", "www.example.com"));
+}
+
+TEST(RegistrableDomainCacheTest, StaysCorrectWhenFull) {
+  RegistrableDomainCache cache(32);
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(base::StringPrintf("site%d.org", i),
+                cache.GetRegistrableDomain(
+                    base::StringPrintf("www.site%d.org", i)));
+    }
+  }
+}
+
+TEST(RegistrableDomainCacheTest, ConcurrentLookups) {
+  RegistrableDomainCache cache(256);
+  std::vector<std::unique_ptr<LookupThread>> delegates;
+  std::vector<std::unique_ptr<base::DelegateSimpleThread>> threads;
+  for (int i = 0; i < 4; ++i) {
+    delegates.push_back(std::make_unique<LookupThread>(&cache));
+    threads.push_back(std::make_unique<base::DelegateSimpleThread>(
+        delegates.back().get(), base::StringPrintf("lookup%d", i)));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Join();
+}
+
+// Compares cached and uncached third-party checks over a short trace.
+TEST(RegistrableDomainCacheTest, MatchesUncachedOverTrace) {
+  const std::vector<GURL> urls = GetRequestUrls();
+  RegistrableDomainCache cache(8);
+  for (const auto& request : CreateRequestTrace(10000)) {
+    EXPECT_EQ(
+        !net::registry_controlled_domains::SameDomainOrHost(
+            urls[request.first], urls[request.second],
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES),
+        cache.IsThirdParty(urls[request.first].host_piece(),
+                           urls[request.second].host_piece()));
+  }
+}
+
+// Compares cached and uncached third-party checks over 1M requests.
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(RegistrableDomainCacheTest, DISABLED_Benchmark) {
+  constexpr int kRequests = 1000000;
+  const std::vector<GURL> urls = GetRequestUrls();
+  const std::vector<std::pair<size_t, size_t>> trace =
+      CreateRequestTrace(kRequests);
+
+  int uncached_third_party = 0;
+  base::ElapsedTimer uncached_timer;
+  for (const auto& request : trace) {
+    if (!net::registry_controlled_domains::SameDomainOrHost(
+            urls[request.first], urls[request.second],
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+      ++uncached_third_party;
+    }
+  }
+  const base::TimeDelta uncached_time = uncached_timer.Elapsed();
+
+  RegistrableDomainCache cache;
+  int cached_third_party = 0;
+  base::ElapsedTimer cached_timer;
+  for (const auto& request : trace) {
+    if (cache.IsThirdParty(urls[request.first].host_piece(),
+                           urls[request.second].host_piece())) {
+      ++cached_third_party;
+    }
+  }
+  const base::TimeDelta cached_time = cached_timer.Elapsed();
+
+  EXPECT_EQ(uncached_third_party, cached_third_party);
+  LOG(INFO) << kRequests << " third-party checks: uncached " << uncached_time
+            << ", cached " << cached_time;
+}
+
+}  // namespace brave_shields
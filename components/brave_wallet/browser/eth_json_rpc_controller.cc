@@ -5,9 +5,14 @@
 
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/environment.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/location.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/eth_call_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
@@ -44,6 +49,26 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// How long ScheduleRequest waits for more calls to join a batch.
+constexpr base::TimeDelta kBatchWindow = base::TimeDelta::FromMilliseconds(10);
+// Reads against the latest block go stale with the next block (~13s).
+constexpr base::TimeDelta kLatestBlockCacheTTL =
+    base::TimeDelta::FromSeconds(5);
+// Domain records change rarely, and a stale answer only delays an update.
+constexpr base::TimeDelta kDomainResolutionCacheTTL =
+    base::TimeDelta::FromMinutes(5);
+const size_t kMaxCachedResponses = 256;
+
+bool IsSuccessResponse(const int status) {
+  return status >= 200 && status <= 299;
+}
+
+// Only cache answers which carry a result, never JSON-RPC errors.
+bool HasJsonRpcResult(const std::string& body) {
+  base::Optional<base::Value> value = base::JSONReader::Read(body);
+  return value && value->is_dict() && value->FindKey("result");
+}
+
 std::string GetInfuraProjectID() {
   std::string project_id(BRAVE_INFURA_PROJECT_ID);
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -67,15 +92,213 @@ namespace brave_wallet {
 
 EthJsonRpcController::EthJsonRpcController(content::BrowserContext* context,
                                            Network network)
-    : context_(context), network_(network) {
+    : context_(context), network_(network), weak_ptr_factory_(this) {
   SetNetwork(network);
 }
 
 EthJsonRpcController::~EthJsonRpcController() {}
 
+EthJsonRpcController::PendingRequest::PendingRequest() = default;
+EthJsonRpcController::PendingRequest::~PendingRequest() = default;
+EthJsonRpcController::PendingRequest::PendingRequest(PendingRequest&&) =
+    default;
+EthJsonRpcController::PendingRequest&
+EthJsonRpcController::PendingRequest::operator=(PendingRequest&&) = default;
+
 void EthJsonRpcController::Request(const std::string& json_payload,
                                    URLRequestCallback callback,
                                    bool auto_retry_on_network_change) {
+  SendRequest(json_payload, std::move(callback), auto_retry_on_network_change);
+}
+
+void EthJsonRpcController::ScheduleRequest(const std::string& json_payload,
+                                           base::TimeDelta cache_ttl,
+                                           URLRequestCallback callback) {
+  const std::string key = GetCacheKey(json_payload);
+  if (const CachedResponse* cached = GetCachedResponse(key)) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&EthJsonRpcController::OnCachedResponse,
+                                  weak_ptr_factory_.GetWeakPtr(),
+                                  std::move(callback), cached->status,
+                                  cached->body, cached->headers));
+    return;
+  }
+
+  auto it = pending_requests_.find(key);
+  if (it != pending_requests_.end()) {
+    it->second.cache_ttl = std::max(it->second.cache_ttl, cache_ttl);
+    it->second.callbacks.push_back(std::move(callback));
+    return;
+  }
+
+  PendingRequest& pending = pending_requests_[key];
+  pending.cache_ttl = cache_ttl;
+  pending.callbacks.push_back(std::move(callback));
+  batch_queue_.push_back(key);
+  if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE, kBatchWindow,
+                       base::BindOnce(&EthJsonRpcController::FlushBatch,
+                                      base::Unretained(this)));
+  }
+}
+
+void EthJsonRpcController::OnCachedResponse(
+    URLRequestCallback callback,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  std::move(callback).Run(status, body, headers);
+}
+
+std::string EthJsonRpcController::GetCacheKey(
+    const std::string& json_payload) const {
+  return network_url_.spec() + "\n" + json_payload;
+}
+
+const EthJsonRpcController::CachedResponse*
+EthJsonRpcController::GetCachedResponse(const std::string& key) const {
+  auto it = response_cache_.find(key);
+  if (it == response_cache_.end() ||
+      it->second.expiry <= base::TimeTicks::Now()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void EthJsonRpcController::CacheResponse(
+    const std::string& key,
+    base::TimeDelta cache_ttl,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  if (cache_ttl.is_zero() || !IsSuccessResponse(status) ||
+      !HasJsonRpcResult(body)) {
+    return;
+  }
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (response_cache_.size() >= kMaxCachedResponses) {
+    for (auto it = response_cache_.begin(); it != response_cache_.end();) {
+      if (it->second.expiry <= now)
+        it = response_cache_.erase(it);
+      else
+        ++it;
+    }
+    if (response_cache_.size() >= kMaxCachedResponses)
+      response_cache_.clear();
+  }
+  response_cache_[key] = {status, body, headers, now + cache_ttl};
+}
+
+void EthJsonRpcController::FlushBatch() {
+  batch_timer_.Stop();
+  if (batch_queue_.empty())
+    return;
+
+  std::vector<std::string> keys;
+  keys.swap(batch_queue_);
+  const size_t prefix_length = network_url_.spec().size() + 1;
+  std::vector<std::string> payloads;
+  for (const auto& key : keys)
+    payloads.push_back(key.substr(prefix_length));
+
+  if (keys.size() == 1) {
+    SendRequest(payloads[0],
+                base::BindOnce(&EthJsonRpcController::CompletePendingRequest,
+                               weak_ptr_factory_.GetWeakPtr(), keys[0]),
+                true);
+    return;
+  }
+
+  // Requests in a batch get their position as id so that responses, which
+  // may come back in any order, can be matched to their callers.
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    base::Optional<base::Value> request = base::JSONReader::Read(payloads[i]);
+    if (!request || !request->is_dict()) {
+      request = base::Value(base::Value::Type::DICTIONARY);
+      request->SetStringKey("jsonrpc", "2.0");
+    }
+    request->SetIntKey("id", static_cast<int>(i));
+    batch.Append(std::move(*request));
+  }
+  std::string batch_payload;
+  base::JSONWriter::Write(batch, &batch_payload);
+
+  SendRequest(batch_payload,
+              base::BindOnce(&EthJsonRpcController::OnBatchResponse,
+                             weak_ptr_factory_.GetWeakPtr(), std::move(keys),
+                             std::move(payloads)),
+              true);
+}
+
+void EthJsonRpcController::OnBatchResponse(
+    std::vector<std::string> keys,
+    std::vector<std::string> payloads,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  base::Optional<base::Value> responses;
+  if (IsSuccessResponse(status))
+    responses = base::JSONReader::Read(body);
+
+  if (!responses || !responses->is_list()) {
+    if (IsSuccessResponse(status)) {
+      // The node does not support batches, resend the calls one by one.
+      for (size_t i = 0; i < keys.size(); ++i) {
+        SendRequest(
+            payloads[i],
+            base::BindOnce(&EthJsonRpcController::CompletePendingRequest,
+                           weak_ptr_factory_.GetWeakPtr(), keys[i]),
+            true);
+      }
+      return;
+    }
+    for (const auto& key : keys)
+      CompletePendingRequest(key, status, body, headers);
+    return;
+  }
+
+  std::vector<std::string> bodies(keys.size());
+  for (auto& response : responses->GetList()) {
+    if (!response.is_dict())
+      continue;
+    base::Optional<int> id = response.FindIntKey("id");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= keys.size())
+      continue;
+    // Hand callers back the id they sent.
+    base::Optional<base::Value> request =
+        base::JSONReader::Read(payloads[*id]);
+    const base::Value* original_id =
+        request ? request->FindKey("id") : nullptr;
+    if (original_id)
+      response.SetKey("id", original_id->Clone());
+    base::JSONWriter::Write(response, &bodies[*id]);
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i)
+    CompletePendingRequest(keys[i], status, bodies[i], headers);
+}
+
+void EthJsonRpcController::CompletePendingRequest(
+    const std::string& key,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  auto it = pending_requests_.find(key);
+  if (it == pending_requests_.end())
+    return;
+  PendingRequest pending = std::move(it->second);
+  pending_requests_.erase(it);
+
+  CacheResponse(key, pending.cache_ttl, status, body, headers);
+  for (auto& callback : pending.callbacks)
+    std::move(callback).Run(status, body, headers);
+}
+
+void EthJsonRpcController::SendRequest(const std::string& json_payload,
+                                       URLRequestCallback callback,
+                                       bool auto_retry_on_network_change) {
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = network_url_;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
@@ -140,6 +363,9 @@ GURL EthJsonRpcController::GetNetworkURL() const {
 }
 
 void EthJsonRpcController::SetNetwork(Network network) {
+  // Queued calls were made against the current network.
+  FlushBatch();
+  response_cache_.clear();
   std::string subdomain;
   network_ = network;
   switch (network) {
@@ -174,6 +400,8 @@ void EthJsonRpcController::SetNetwork(Network network) {
 }
 
 void EthJsonRpcController::SetCustomNetwork(const GURL& network_url) {
+  FlushBatch();
+  response_cache_.clear();
   network_ = Network::kCustom;
   network_url_ = network_url;
 }
@@ -184,8 +412,8 @@ void EthJsonRpcController::GetBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBalance,
                      base::Unretained(this), std::move(callback));
-  return Request(eth_getBalance(address, "latest"),
-                 std::move(internal_callback), true);
+  ScheduleRequest(eth_getBalance(address, "latest"), kLatestBlockCacheTTL,
+                  std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBalance(
@@ -217,8 +445,8 @@ bool EthJsonRpcController::GetERC20TokenBalance(
   if (!erc20::BalanceOf(address, &data)) {
     return false;
   }
-  Request(eth_call("", address, "", "", "", data, ""),
-          std::move(internal_callback), true);
+  ScheduleRequest(eth_call("", address, "", "", "", data, ""),
+                  kLatestBlockCacheTTL, std::move(internal_callback));
   return true;
 }
 
@@ -252,11 +480,26 @@ bool EthJsonRpcController::UnstoppableDomainsProxyReaderGetMany(
     return false;
   }
 
-  Request(eth_call("", contract_address, "", "", "", data, "latest"),
-          std::move(internal_callback), true);
+  ScheduleRequest(eth_call("", contract_address, "", "", "", data, "latest"),
+                  kDomainResolutionCacheTTL, std::move(internal_callback));
   return true;
 }
 
+bool EthJsonRpcController::GetCachedUnstoppableDomainsProxyReaderGetMany(
+    const std::string& contract_address,
+    const std::string& domain,
+    const std::vector<std::string>& keys,
+    std::string* result) {
+  std::string data;
+  if (!unstoppable_domains::GetMany(keys, domain, &data)) {
+    return false;
+  }
+
+  const CachedResponse* cached = GetCachedResponse(GetCacheKey(
+      eth_call("", contract_address, "", "", "", data, "latest")));
+  return cached && ParseEthCall(cached->body, result);
+}
+
 void EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany(
     UnstoppableDomainsProxyReaderGetManyCallback callback,
     const int status,
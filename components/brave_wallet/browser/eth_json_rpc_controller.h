@@ -13,6 +13,9 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "url/gurl.h"
 
@@ -38,6 +41,13 @@ class EthJsonRpcController {
   void Request(const std::string& json_payload,
                URLRequestCallback callback,
                bool auto_retry_on_network_change);
+  // Like Request, but for read-only calls: payloads scheduled within a few
+  // milliseconds of each other are sent together as one JSON-RPC batch,
+  // identical payloads share a single in-flight request, and successful
+  // results are answered from memory for |cache_ttl| afterwards.
+  void ScheduleRequest(const std::string& json_payload,
+                       base::TimeDelta cache_ttl,
+                       URLRequestCallback callback);
   using GetBallanceCallback =
       base::OnceCallback<void(bool status, const std::string& balance)>;
   void GetBalance(const std::string& address, GetBallanceCallback callback);
@@ -56,6 +66,13 @@ class EthJsonRpcController {
       const std::string& domain,
       const std::vector<std::string>& keys,
       UnstoppableDomainsProxyReaderGetManyCallback callback);
+  // Synchronous variant which only consults the response cache. Returns false
+  // if there is no fresh cached result for the call.
+  bool GetCachedUnstoppableDomainsProxyReaderGetMany(
+      const std::string& contract_address,
+      const std::string& domain,
+      const std::vector<std::string>& keys,
+      std::string* result);
 
   Network GetNetwork() const;
   GURL GetNetworkURL() const;
@@ -69,6 +86,49 @@ class EthJsonRpcController {
  private:
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  struct PendingRequest {
+    PendingRequest();
+    ~PendingRequest();
+    PendingRequest(PendingRequest&&);
+    PendingRequest& operator=(PendingRequest&&);
+
+    base::TimeDelta cache_ttl;
+    std::vector<URLRequestCallback> callbacks;
+  };
+
+  struct CachedResponse {
+    int status = 0;
+    std::string body;
+    std::map<std::string, std::string> headers;
+    base::TimeTicks expiry;
+  };
+
+  void SendRequest(const std::string& json_payload,
+                   URLRequestCallback callback,
+                   bool auto_retry_on_network_change);
+  std::string GetCacheKey(const std::string& json_payload) const;
+  const CachedResponse* GetCachedResponse(const std::string& key) const;
+  void CacheResponse(const std::string& key,
+                     base::TimeDelta cache_ttl,
+                     const int status,
+                     const std::string& body,
+                     const std::map<std::string, std::string>& headers);
+  void FlushBatch();
+  void OnBatchResponse(std::vector<std::string> keys,
+                       std::vector<std::string> payloads,
+                       const int status,
+                       const std::string& body,
+                       const std::map<std::string, std::string>& headers);
+  void CompletePendingRequest(
+      const std::string& key,
+      const int status,
+      const std::string& body,
+      const std::map<std::string, std::string>& headers);
+  void OnCachedResponse(URLRequestCallback callback,
+                        const int status,
+                        const std::string& body,
+                        const std::map<std::string, std::string>& headers);
   void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
                            URLRequestCallback callback,
                            const std::unique_ptr<std::string> response_body);
@@ -92,6 +152,15 @@ class EthJsonRpcController {
   GURL network_url_;
   SimpleURLLoaderList url_loaders_;
   Network network_;
+
+  // Keyed by network URL and payload, see GetCacheKey().
+  std::map<std::string, PendingRequest> pending_requests_;
+  std::map<std::string, CachedResponse> response_cache_;
+  // Keys of pending requests waiting for |batch_timer_| to fire.
+  std::vector<std::string> batch_queue_;
+  base::OneShotTimer batch_timer_;
+
+  base::WeakPtrFactory<EthJsonRpcController> weak_ptr_factory_;
 };
 
 }  // namespace brave_wallet
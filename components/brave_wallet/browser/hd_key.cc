@@ -5,8 +5,11 @@
 
 #include "brave/components/brave_wallet/browser/hd_key.h"
 
+#include <utility>
+
 #include "base/check.h"
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
@@ -27,6 +30,9 @@ constexpr char kMasterSecret[] = "Bitcoin seed";
 }  // namespace
 
 HDKey::HDKey()
+    : HDKey(secp256k1_context_create(SECP256K1_CONTEXT_SIGN |
+                                     SECP256K1_CONTEXT_VERIFY)) {}
+HDKey::HDKey(secp256k1_context* secp256k1_ctx)
     : depth_(0),
       fingerprint_(0),
       parent_fingerprint_(0),
@@ -35,8 +41,7 @@ HDKey::HDKey()
       private_key_(0),
       public_key_(33),
       chain_code_(32),
-      secp256k1_ctx_(secp256k1_context_create(SECP256K1_CONTEXT_SIGN |
-                                              SECP256K1_CONTEXT_VERIFY)) {}
+      secp256k1_ctx_(secp256k1_ctx) {}
 HDKey::HDKey(uint8_t depth, uint32_t parent_fingerprint, uint32_t index)
     : depth_(depth),
       fingerprint_(0),
@@ -193,7 +198,36 @@ void HDKey::SetChainCode(const std::vector<uint8_t>& value) {
 }
 
 std::unique_ptr<HDKey> HDKey::DeriveChild(uint32_t index) {
-  std::unique_ptr<HDKey> hdkey = std::make_unique<HDKey>();
+  std::vector<std::unique_ptr<HDKey>> children = DeriveChildren(index, 1);
+  return std::move(children.front());
+}
+
+std::vector<std::unique_ptr<HDKey>> HDKey::DeriveChildren(uint32_t start_index,
+                                                          size_t count) {
+  std::vector<std::unique_ptr<HDKey>> children;
+  bssl::ScopedHMAC_CTX parent_hmac;
+  if (!HMAC_Init_ex(parent_hmac.get(), chain_code_.data(), chain_code_.size(),
+                    EVP_sha512(), nullptr)) {
+    LOG(ERROR) << __func__ << ": HMAC_Init_ex failed";
+    children.resize(count);
+    return children;
+  }
+
+  children.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    children.push_back(
+        DeriveChildWithHMAC(start_index + static_cast<uint32_t>(i),
+                            parent_hmac.get()));
+  }
+  return children;
+}
+
+std::unique_ptr<HDKey> HDKey::DeriveChildWithHMAC(
+    uint32_t index,
+    const HMAC_CTX* parent_hmac) {
+  // Cloning the context skips recomputing its precomputed tables.
+  std::unique_ptr<HDKey> hdkey =
+      base::WrapUnique(new HDKey(secp256k1_context_clone(secp256k1_ctx_)));
   bool is_hardened = index >= HARDENED_OFFSET;
   std::vector<uint8_t> data;
 
@@ -216,8 +250,10 @@ std::unique_ptr<HDKey> HDKey::DeriveChild(uint32_t index) {
   size_t hmac_length = EVP_MD_size(EVP_sha512());
   std::vector<uint8_t> hmac(hmac_length);
   unsigned int out_len;
-  if (!HMAC(EVP_sha512(), chain_code_.data(), chain_code_.size(), data.data(),
-            data.size(), hmac.data(), &out_len)) {
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  if (!HMAC_CTX_copy_ex(hmac_ctx.get(), parent_hmac) ||
+      !HMAC_Update(hmac_ctx.get(), data.data(), data.size()) ||
+      !HMAC_Final(hmac_ctx.get(), hmac.data(), &out_len)) {
     LOG(ERROR) << __func__ << ": HMAC_SHA512 failed";
     return nullptr;
   }
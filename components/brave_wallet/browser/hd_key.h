@@ -12,6 +12,7 @@
 
 #include "base/gtest_prod_util.h"
 #include "brave/third_party/bitcoin-core/src/src/secp256k1/include/secp256k1.h"
+#include "third_party/boringssl/src/include/openssl/base.h"
 
 namespace brave_wallet {
 
@@ -50,6 +51,12 @@ class HDKey {
   // 0 to 2^31-1 is normal derivation and 2^31 to 2^32-1 is harden derivation
   // If anything failed, nullptr will be returned
   std::unique_ptr<HDKey> DeriveChild(uint32_t index);
+  // Derives |count| consecutive children starting at |start_index|. Cheaper
+  // than calling DeriveChild() |count| times because the keyed HMAC state and
+  // the signing context are set up once and reused for every child.
+  // Children which fail to derive are nullptr.
+  std::vector<std::unique_ptr<HDKey>> DeriveChildren(uint32_t start_index,
+                                                     size_t count);
   // path format: m/[n|n']*/[n|n']*...
   // n: 0 to 2^31-1 (normal derivation)
   // n': n + 2^31 (harden derivation)
@@ -80,6 +87,12 @@ class HDKey {
   FRIEND_TEST_ALL_PREFIXES(HDKeyUnitTest, DeriveChildFromPath);
   FRIEND_TEST_ALL_PREFIXES(HDKeyUnitTest, SignAndVerifyAndRecover);
 
+  // Takes ownership of |secp256k1_ctx|.
+  explicit HDKey(secp256k1_context* secp256k1_ctx);
+
+  // |parent_hmac| is an HMAC-SHA512 context keyed with |chain_code_|.
+  std::unique_ptr<HDKey> DeriveChildWithHMAC(uint32_t index,
+                                             const HMAC_CTX* parent_hmac);
   void GeneratePublicKey();
   const std::vector<uint8_t> Hash160(const std::vector<uint8_t>& input);
   std::string Serialize(uint32_t version,
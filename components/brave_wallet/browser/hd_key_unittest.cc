@@ -331,4 +331,30 @@ TEST(HDKeyUnitTest, DeriveChildFromPath) {
   }
 }
 
+TEST(HDKeyUnitTest, DeriveChildren) {
+  std::unique_ptr<HDKey> m_key =
+      HDKey::GenerateFromSeed(std::vector<uint8_t>(32));
+  std::unique_ptr<HDKey> parent = m_key->DeriveChildFromPath("m/44'/60'/0'/0");
+  ASSERT_TRUE(parent);
+
+  std::vector<std::unique_ptr<HDKey>> children = parent->DeriveChildren(3, 4);
+  ASSERT_EQ(children.size(), 4u);
+  for (size_t i = 0; i < children.size(); ++i) {
+    ASSERT_TRUE(children[i]);
+    std::unique_ptr<HDKey> child = parent->DeriveChild(3 + i);
+    EXPECT_EQ(children[i]->GetPrivateExtendedKey(),
+              child->GetPrivateExtendedKey());
+    EXPECT_EQ(children[i]->GetPublicExtendedKey(),
+              child->GetPublicExtendedKey());
+  }
+
+  // Hardened children
+  children = parent->DeriveChildren(0x80000000, 2);
+  ASSERT_EQ(children.size(), 2u);
+  EXPECT_EQ(children[1]->GetPrivateExtendedKey(),
+            parent->DeriveChild(0x80000001)->GetPrivateExtendedKey());
+
+  EXPECT_TRUE(parent->DeriveChildren(0, 0).empty());
+}
+
 }  // namespace brave_wallet
@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 
+#include <utility>
+
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_address.h"
@@ -27,6 +29,8 @@ void HDKeyring::ClearData() {
   root_.reset();
   master_key_.reset();
   accounts_.clear();
+  addresses_.clear();
+  address_to_index_.clear();
 }
 
 void HDKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
@@ -40,35 +44,41 @@ void HDKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
 }
 
 void HDKeyring::AddAccounts(size_t number) {
-  size_t cur_accounts_number = accounts_.size();
-  for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
-    if (root_) {
-      accounts_.push_back(root_->DeriveChild(i));
-    }
+  if (!root_)
+    return;
+  std::vector<std::unique_ptr<HDKey>> children =
+      root_->DeriveChildren(accounts_.size(), number);
+  for (auto& child : children) {
+    if (child)
+      accounts_.push_back(std::move(child));
   }
 }
 
 std::vector<std::string> HDKeyring::GetAccounts() {
-  std::vector<std::string> addresses;
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    addresses.push_back(GetAddress(i));
-  }
-  return addresses;
+  UpdateAddressCache();
+  return addresses_;
 }
 
 void HDKeyring::RemoveAccount(const std::string& address) {
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address) {
-      accounts_.erase(accounts_.begin() + i);
-    }
-  }
+  UpdateAddressCache();
+  auto it = address_to_index_.find(address);
+  if (it == address_to_index_.end())
+    return;
+  const size_t index = it->second;
+  accounts_.erase(accounts_.begin() + index);
+  addresses_.erase(addresses_.begin() + index);
+  RebuildAddressIndex();
 }
 
 std::string HDKeyring::GetAddress(size_t index) {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
-  const std::vector<uint8_t> public_key =
-      accounts_[index]->GetUncompressedPublicKey();
+  UpdateAddressCache();
+  return addresses_[index];
+}
+
+std::string HDKeyring::ComputeAddress(const HDKey& hd_key) const {
+  const std::vector<uint8_t> public_key = hd_key.GetUncompressedPublicKey();
   // trim the header byte 0x04
   const std::vector<uint8_t> pubkey_no_header(public_key.begin() + 1,
                                               public_key.end());
@@ -78,6 +88,23 @@ std::string HDKeyring::GetAddress(size_t index) {
   return addr.ToChecksumAddress();
 }
 
+void HDKeyring::UpdateAddressCache() {
+  if (addresses_.size() > accounts_.size()) {
+    addresses_.clear();
+    address_to_index_.clear();
+  }
+  for (size_t i = addresses_.size(); i < accounts_.size(); ++i) {
+    addresses_.push_back(ComputeAddress(*accounts_[i]));
+    address_to_index_.emplace(addresses_.back(), i);
+  }
+}
+
+void HDKeyring::RebuildAddressIndex() {
+  address_to_index_.clear();
+  for (size_t i = 0; i < addresses_.size(); ++i)
+    address_to_index_.emplace(addresses_[i], i);
+}
+
 void HDKeyring::SignTransaction(const std::string& address,
                                 EthTransaction* tx) {
   HDKey* hd_key = GetHDKeyFromAddress(address);
@@ -109,11 +136,11 @@ std::vector<uint8_t> HDKeyring::SignMessage(
 }
 
 HDKey* HDKeyring::GetHDKeyFromAddress(const std::string& address) {
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return accounts_[i].get();
-  }
-  return nullptr;
+  UpdateAddressCache();
+  auto it = address_to_index_.find(address);
+  if (it == address_to_index_.end())
+    return nullptr;
+  return accounts_[it->second].get();
 }
 
 }  // namespace brave_wallet
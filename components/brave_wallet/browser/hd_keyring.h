@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/gtest_prod_util.h"
@@ -38,7 +39,6 @@ class HDKeyring {
   virtual std::vector<std::string> GetAccounts();
   virtual void RemoveAccount(const std::string& address);
 
-  // Bitcoin keyring can override this for different address calculation
   virtual std::string GetAddress(size_t index);
 
   // TODO(darkdh): Abstract Transacation class
@@ -50,6 +50,8 @@ class HDKeyring {
 
  protected:
   HDKey* GetHDKeyFromAddress(const std::string& address);
+  // Bitcoin keyring can override this for different address calculation
+  virtual std::string ComputeAddress(const HDKey& hd_key) const;
 
   std::unique_ptr<HDKey> root_;
   std::unique_ptr<HDKey> master_key_;
@@ -59,6 +61,14 @@ class HDKeyring {
   FRIEND_TEST_ALL_PREFIXES(HDKeyringUnitTest, ConstructRootHDKey);
   FRIEND_TEST_ALL_PREFIXES(HDKeyringUnitTest, SignMessage);
 
+  // Computes addresses of accounts appended since the last call.
+  void UpdateAddressCache();
+  void RebuildAddressIndex();
+
+  // Address of each entry in |accounts_|, computed once per account.
+  std::vector<std::string> addresses_;
+  std::unordered_map<std::string, size_t> address_to_index_;
+
   HDKeyring(const HDKeyring&) = delete;
   HDKeyring& operator=(const HDKeyring&) = delete;
 };
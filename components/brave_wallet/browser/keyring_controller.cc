@@ -5,8 +5,12 @@
 
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
+#include <utility>
+
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -17,10 +21,19 @@ namespace brave_wallet {
 namespace {
 const size_t kSaltSize = 32;
 const size_t kNonceSize = 12;
+const size_t kPbkdf2Iterations = 100000;
+const size_t kPbkdf2KeySize = 256;
 
 static base::span<const uint8_t> ToSpan(base::StringPiece sp) {
   return base::as_bytes(base::make_span(sp));
 }
+
+std::unique_ptr<PasswordEncryptor> DeriveEncryptor(
+    const std::string& password,
+    const std::vector<uint8_t>& salt) {
+  return PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+}
 }  // namespace
 
 KeyringController::KeyringController(PrefService* prefs) : prefs_(prefs) {
@@ -53,6 +66,10 @@ HDKeyring* KeyringController::ResumeDefaultKeyring(
     return nullptr;
   }
 
+  return ResumeDefaultKeyringWithEncryptor();
+}
+
+HDKeyring* KeyringController::ResumeDefaultKeyringWithEncryptor() {
   const std::string mnemonic = GetMnemonicForDefaultKeyring();
   if (mnemonic.empty() || !CreateDefaultKeyringInternal(mnemonic)) {
     return nullptr;
@@ -80,6 +97,47 @@ HDKeyring* KeyringController::RestoreDefaultKeyring(
   return default_keyring_.get();
 }
 
+void KeyringController::CreateDefaultKeyring(const std::string& password,
+                                             KeyringCallback callback) {
+  CreateEncryptor(
+      password,
+      base::BindOnce(&KeyringController::OnEncryptorCreatedForNewKeyring,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void KeyringController::OnEncryptorCreatedForNewKeyring(
+    KeyringCallback callback,
+    bool success) {
+  if (!success || !CreateDefaultKeyringInternal(GenerateMnemonic(16))) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+  std::move(callback).Run(default_keyring_.get());
+}
+
+void KeyringController::RestoreDefaultKeyring(const std::string& mnemonic,
+                                              const std::string& password,
+                                              KeyringCallback callback) {
+  Reset();
+
+  CreateEncryptor(
+      password,
+      base::BindOnce(&KeyringController::OnEncryptorCreatedForRestore,
+                     weak_ptr_factory_.GetWeakPtr(), mnemonic,
+                     std::move(callback)));
+}
+
+void KeyringController::OnEncryptorCreatedForRestore(
+    const std::string& mnemonic,
+    KeyringCallback callback,
+    bool success) {
+  if (!success || !CreateDefaultKeyringInternal(mnemonic)) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+  std::move(callback).Run(default_keyring_.get());
+}
+
 std::string KeyringController::GetMnemonicForDefaultKeyring() {
   if (IsLocked()) {
     LOG(ERROR) << __func__ << ": Must Unlock controller first";
@@ -112,6 +170,8 @@ bool KeyringController::IsLocked() const {
 }
 
 void KeyringController::Lock() {
+  // Drop the result of any unlock still in flight.
+  ++encryptor_request_id_;
   if (IsLocked() || !default_keyring_)
     return;
   // invalidate keyring and save account number
@@ -131,7 +191,31 @@ bool KeyringController::Unlock(const std::string& password) {
   return true;
 }
 
+void KeyringController::Unlock(const std::string& password,
+                               UnlockCallback callback) {
+  CreateEncryptor(
+      password,
+      base::BindOnce(&KeyringController::OnEncryptorCreatedForUnlock,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void KeyringController::OnEncryptorCreatedForUnlock(UnlockCallback callback,
+                                                    bool success) {
+  if (!success) {
+    std::move(callback).Run(false);
+    return;
+  }
+  // A wrong password still derives a key, decrypting the mnemonic fails.
+  if (!ResumeDefaultKeyringWithEncryptor()) {
+    encryptor_.reset();
+    std::move(callback).Run(false);
+    return;
+  }
+  std::move(callback).Run(true);
+}
+
 void KeyringController::Reset() {
+  ++encryptor_request_id_;
   prefs_->ClearPref(kBraveWalletPasswordEncryptorSalt);
   prefs_->ClearPref(kBraveWalletPasswordEncryptorNonce);
   encryptor_.reset();
@@ -173,19 +257,50 @@ std::vector<uint8_t> KeyringController::GetOrCreateNonce() {
   return nonce;
 }
 
-bool KeyringController::CreateEncryptor(const std::string& password) {
-  if (password.empty())
-    return false;
+std::vector<uint8_t> KeyringController::GetOrCreateSalt() {
   std::vector<uint8_t> salt(kSaltSize);
   if (!GetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, &salt)) {
     crypto::RandBytes(salt);
     SetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, salt);
   }
-  encryptor_ = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, 100000, 256);
+  return salt;
+}
+
+bool KeyringController::CreateEncryptor(const std::string& password) {
+  if (password.empty())
+    return false;
+  encryptor_ = DeriveEncryptor(password, GetOrCreateSalt());
   return encryptor_ != nullptr;
 }
 
+void KeyringController::CreateEncryptor(const std::string& password,
+                                        UnlockCallback callback) {
+  if (password.empty()) {
+    std::move(callback).Run(false);
+    return;
+  }
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DeriveEncryptor, password, GetOrCreateSalt()),
+      base::BindOnce(&KeyringController::OnEncryptorCreated,
+                     weak_ptr_factory_.GetWeakPtr(), ++encryptor_request_id_,
+                     std::move(callback)));
+}
+
+void KeyringController::OnEncryptorCreated(
+    uint64_t request_id,
+    UnlockCallback callback,
+    std::unique_ptr<PasswordEncryptor> encryptor) {
+  if (request_id != encryptor_request_id_ || !encryptor) {
+    std::move(callback).Run(false);
+    return;
+  }
+  encryptor_ = std::move(encryptor);
+  std::move(callback).Run(true);
+}
+
 bool KeyringController::CreateDefaultKeyringInternal(
     const std::string& mnemonic) {
   if (!encryptor_)
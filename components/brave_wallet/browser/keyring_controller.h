@@ -10,7 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/password_encryptor.h"
 
 class PrefService;
@@ -28,10 +30,14 @@ FORWARD_DECLARE_TEST(KeyringControllerUnitTest, CreateDefaultKeyringInternal);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, LockAndUnlock);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, Reset);
+FORWARD_DECLARE_TEST(KeyringControllerUnitTest, LockDuringUnlock);
 
 // This class is not thread-safe and should have single owner
 class KeyringController {
  public:
+  using KeyringCallback = base::OnceCallback<void(HDKeyring*)>;
+  using UnlockCallback = base::OnceCallback<void(bool)>;
+
   explicit KeyringController(PrefService* prefs);
   ~KeyringController();
 
@@ -41,6 +47,15 @@ class KeyringController {
   // Restore default keyring from backup seed phrase
   HDKeyring* RestoreDefaultKeyring(const std::string& mnemonic,
                                    const std::string& password);
+
+  // Asynchronous versions of the above. The password based key derivation
+  // runs on the thread pool so callers on the UI thread don't block on it.
+  // The keyring passed to |callback| is nullptr on failure.
+  void CreateDefaultKeyring(const std::string& password,
+                            KeyringCallback callback);
+  void RestoreDefaultKeyring(const std::string& mnemonic,
+                             const std::string& password,
+                             KeyringCallback callback);
   // Must unlock before using this API otherwise it will return empty string
   std::string GetMnemonicForDefaultKeyring();
   // Must unlock before using this API otherwise it will return nullptr
@@ -50,6 +65,7 @@ class KeyringController {
   bool IsLocked() const;
   void Lock();
   bool Unlock(const std::string& password);
+  void Unlock(const std::string& password, UnlockCallback callback);
 
   /* TODO(darkdh): For other keyrings support
   void DeleteKeyring(size_t index);
@@ -69,15 +85,30 @@ class KeyringController {
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, LockAndUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, Reset);
+  FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, LockDuringUnlock);
 
   bool GetPrefsInBytes(const std::string& path, std::vector<uint8_t>* bytes);
   void SetPrefsInBytes(const std::string& path,
                        base::span<const uint8_t> bytes);
   std::vector<uint8_t> GetOrCreateNonce();
+  std::vector<uint8_t> GetOrCreateSalt();
   bool CreateEncryptor(const std::string& password);
+  // Derives the encryptor on the thread pool. |callback| gets false if
+  // derivation failed or Lock()/Reset() was called meanwhile.
+  void CreateEncryptor(const std::string& password, UnlockCallback callback);
+  void OnEncryptorCreated(uint64_t request_id,
+                          UnlockCallback callback,
+                          std::unique_ptr<PasswordEncryptor> encryptor);
+  void OnEncryptorCreatedForNewKeyring(KeyringCallback callback, bool success);
+  void OnEncryptorCreatedForRestore(const std::string& mnemonic,
+                                    KeyringCallback callback,
+                                    bool success);
+  void OnEncryptorCreatedForUnlock(UnlockCallback callback, bool success);
   bool CreateDefaultKeyringInternal(const std::string& mnemonic);
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeDefaultKeyring(const std::string& password);
+  // Same as above once |encryptor_| has been created.
+  HDKeyring* ResumeDefaultKeyringWithEncryptor();
 
   std::unique_ptr<PasswordEncryptor> encryptor_;
   std::unique_ptr<HDKeyring> default_keyring_;
@@ -86,6 +117,11 @@ class KeyringController {
   // std::vector<std::unique_ptr<HDKeyring>> keyrings_;
 
   PrefService* prefs_;
+  // Incremented by every asynchronous encryptor request, Lock() and Reset()
+  // so that only the latest request may install its encryptor.
+  uint64_t encryptor_request_id_ = 0;
+
+  base::WeakPtrFactory<KeyringController> weak_ptr_factory_{this};
 
   KeyringController(const KeyringController&) = delete;
   KeyringController& operator=(const KeyringController&) = delete;
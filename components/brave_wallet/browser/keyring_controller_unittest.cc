@@ -6,6 +6,8 @@
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
 #include "base/base64.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "chrome/browser/profiles/profile_manager.h"
@@ -393,4 +395,101 @@ TEST_F(KeyringControllerUnitTest, Reset) {
   EXPECT_EQ(controller.encryptor_, nullptr);
 }
 
+TEST_F(KeyringControllerUnitTest, CreateDefaultKeyringAsync) {
+  KeyringController controller(GetPrefs());
+  base::RunLoop run_loop;
+  HDKeyring* created_keyring = nullptr;
+  controller.CreateDefaultKeyring(
+      "brave", base::BindLambdaForTesting([&](HDKeyring* keyring) {
+        created_keyring = keyring;
+        run_loop.Quit();
+      }));
+  // The key is derived on the thread pool
+  EXPECT_TRUE(controller.IsLocked());
+  run_loop.Run();
+
+  ASSERT_NE(created_keyring, nullptr);
+  EXPECT_FALSE(controller.IsLocked());
+  EXPECT_EQ(controller.GetDefaultKeyring(), created_keyring);
+  EXPECT_FALSE(controller.GetMnemonicForDefaultKeyring().empty());
+}
+
+TEST_F(KeyringControllerUnitTest, RestoreDefaultKeyringAsync) {
+  const std::string seed_phrase =
+      "divide cruise upon flag harsh carbon filter merit once advice bright "
+      "drive";
+  KeyringController controller(GetPrefs());
+  {
+    base::RunLoop run_loop;
+    controller.RestoreDefaultKeyring(
+        seed_phrase, "brave",
+        base::BindLambdaForTesting([&](HDKeyring* keyring) {
+          ASSERT_NE(keyring, nullptr);
+          keyring->AddAccounts(1);
+          EXPECT_EQ(keyring->GetAddress(0),
+                    "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db");
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  }
+  {
+    base::RunLoop run_loop;
+    controller.RestoreDefaultKeyring(
+        seed_phrase, "", base::BindLambdaForTesting([&](HDKeyring* keyring) {
+          EXPECT_EQ(keyring, nullptr);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  }
+}
+
+TEST_F(KeyringControllerUnitTest, UnlockAsync) {
+  KeyringController controller(GetPrefs());
+  HDKeyring* keyring = controller.CreateDefaultKeyring("brave");
+  keyring->AddAccounts(2);
+  const std::string address = keyring->GetAddress(1);
+  controller.Lock();
+
+  auto unlock = [&controller](const std::string& password) {
+    base::RunLoop run_loop;
+    bool result = false;
+    controller.Unlock(password, base::BindLambdaForTesting([&](bool success) {
+                        result = success;
+                        run_loop.Quit();
+                      }));
+    run_loop.Run();
+    return result;
+  };
+
+  EXPECT_FALSE(unlock("brave123"));
+  EXPECT_TRUE(controller.IsLocked());
+  EXPECT_FALSE(unlock(""));
+  EXPECT_TRUE(controller.IsLocked());
+
+  EXPECT_TRUE(unlock("brave"));
+  EXPECT_FALSE(controller.IsLocked());
+  ASSERT_NE(controller.GetDefaultKeyring(), nullptr);
+  EXPECT_EQ(controller.GetDefaultKeyring()->GetAccounts().size(), 2u);
+  EXPECT_EQ(controller.GetDefaultKeyring()->GetAddress(1), address);
+}
+
+TEST_F(KeyringControllerUnitTest, LockDuringUnlock) {
+  KeyringController controller(GetPrefs());
+  ASSERT_NE(controller.CreateDefaultKeyring("brave"), nullptr);
+  controller.default_keyring_->AddAccounts(1);
+  controller.Lock();
+
+  base::RunLoop run_loop;
+  bool result = true;
+  controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                      result = success;
+                      run_loop.Quit();
+                    }));
+  // Locking while the key is being derived drops the unlock
+  controller.Lock();
+  run_loop.Run();
+  EXPECT_FALSE(result);
+  EXPECT_TRUE(controller.IsLocked());
+}
+
 }  // namespace brave_wallet
@@ -5,11 +5,18 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/optional.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/task/post_task.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
@@ -68,13 +75,14 @@ Rule CloneRule(const Rule& rule, bool reverse_patterns = false) {
 
 class BraveShieldsRuleIterator : public RuleIterator {
  public:
-  explicit BraveShieldsRuleIterator(std::vector<Rule> rules)
+  explicit BraveShieldsRuleIterator(
+      scoped_refptr<const base::RefCountedData<std::vector<Rule>>> rules)
       : rules_(std::move(rules)) {
-    iterator_ = rules_.begin();
+    iterator_ = rules_->data.begin();
   }
 
   bool HasNext() const override {
-    return iterator_ != rules_.end();
+    return iterator_ != rules_->data.end();
   }
 
   Rule Next() override {
@@ -82,37 +90,91 @@ class BraveShieldsRuleIterator : public RuleIterator {
   }
 
  private:
-  std::vector<Rule> rules_;
+  scoped_refptr<const base::RefCountedData<std::vector<Rule>>> rules_;
   std::vector<Rule>::const_iterator iterator_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsRuleIterator);
 };
 
+// Indexes shield rules by the host of their primary pattern. A shield rule can
+// only be IDENTITY or SUCCESSOR of a cookie rule pattern if its host is the
+// same as or a parent domain of the cookie rule host, so only those rules need
+// to be compared. The precedence order of |shield_rules| is preserved.
+class ShieldRulesIndex {
+ public:
+  explicit ShieldRulesIndex(const std::vector<Rule>& shield_rules)
+      : shield_rules_(shield_rules) {
+    for (size_t i = 0; i < shield_rules_.size(); ++i) {
+      const std::string& host = shield_rules_[i].primary_pattern.GetHost();
+      if (host.empty())
+        wildcard_host_rules_.push_back(i);
+      else
+        rules_by_host_[host].push_back(i);
+    }
+  }
+
+  bool IsActive(const Rule& cookie_rule) const {
+    // don't include default rules in the iterator
+    if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
+        (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
+         cookie_rule.secondary_pattern ==
+             ContentSettingsPattern::FromString("https://firstParty/*"))) {
+      return false;
+    }
 
-bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
-  // don't include default rules in the iterator
-  if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
-      (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
-       cookie_rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://firstParty/*"))) {
-    return false;
+    for (size_t index : GetCandidates(cookie_rule.primary_pattern.GetHost())) {
+      const Rule& shield_rule = shield_rules_[index];
+      auto primary_compare =
+          shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
+      // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
+      if (primary_compare == ContentSettingsPattern::IDENTITY ||
+          primary_compare == ContentSettingsPattern::SUCCESSOR) {
+        // TODO(bridiver) - move this logic into shields_util for allow/block
+        return ValueToContentSetting(&shield_rule.value) !=
+               CONTENT_SETTING_BLOCK;
+      }
+    }
+
+    return true;
   }
 
-  bool default_value = true;
-  for (const auto& shield_rule : shield_rules) {
-    auto primary_compare =
-        shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
-    // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
-    if (primary_compare == ContentSettingsPattern::IDENTITY ||
-        primary_compare == ContentSettingsPattern::SUCCESSOR) {
-      // TODO(bridiver) - move this logic into shields_util for allow/block
-      return
-          ValueToContentSetting(&shield_rule.value) != CONTENT_SETTING_BLOCK;
+ private:
+  // Returns indices of the shield rules for |host| and its parent domains in
+  // precedence order.
+  std::vector<size_t> GetCandidates(const std::string& host) const {
+    std::vector<size_t> candidates = wildcard_host_rules_;
+    base::StringPiece domain = host;
+    while (!domain.empty()) {
+      auto it = rules_by_host_.find(domain.as_string());
+      if (it != rules_by_host_.end()) {
+        candidates.insert(candidates.end(), it->second.begin(),
+                          it->second.end());
+      }
+      size_t dot = domain.find('.');
+      if (dot == base::StringPiece::npos)
+        break;
+      domain.remove_prefix(dot + 1);
     }
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
   }
 
-  return default_value;
+  const std::vector<Rule>& shield_rules_;
+  std::unordered_map<std::string, std::vector<size_t>> rules_by_host_;
+  std::vector<size_t> wildcard_host_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldRulesIndex);
+};
+
+std::string GetPatternsKey(const Rule& rule) {
+  return base::StrCat({rule.primary_pattern.ToString(), ",",
+                       rule.secondary_pattern.ToString()});
+}
+
+std::string GetRuleKey(const Rule& rule) {
+  return base::StrCat(
+      {GetPatternsKey(rule), ",",
+       base::NumberToString(ValueToContentSetting(&rule.value))});
 }
 
 }  // namespace
@@ -425,26 +487,28 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
       ContentSettingsType content_type,
       bool incognito) const {
   if (content_type == ContentSettingsType::COOKIES) {
-    std::vector<Rule> rules;
-    for (auto i = cookie_rules_.at(incognito).begin();
-         i != cookie_rules_.at(incognito).end();
-         ++i) {
-      rules.emplace_back(CloneRule(*i));
-    }
-
-    return std::make_unique<BraveShieldsRuleIterator>(std::move(rules));
+    return std::make_unique<BraveShieldsRuleIterator>(
+        GetCookieRules(incognito));
   }
 
   return PrefProvider::GetRuleIterator(content_type, incognito);
 }
 
+scoped_refptr<const BravePrefProvider::RuleList>
+BravePrefProvider::GetCookieRules(bool incognito) const {
+  base::AutoLock lock(cookie_rules_lock_);
+  auto it = cookie_rules_.find(incognito);
+  if (it == cookie_rules_.end())
+    return base::MakeRefCounted<RuleList>();
+  return it->second;
+}
+
 void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                                           bool incognito) {
-  auto& rules = cookie_rules_[incognito];
+  std::vector<Rule> rules;
   auto old_rules = std::move(brave_cookie_rules_[incognito]);
-
-  rules.clear();
-  brave_cookie_rules_[incognito].clear();
+  auto& brave_rules = brave_cookie_rules_[incognito];
+  brave_rules.clear();
 
   // kGoogleLoginControlType preference adds an exception for
   // accounts.google.com to access cookies in 3p context to allow login using
@@ -457,23 +521,15 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   // are tightly bound to google, and require google auth to work.
   // See: #5075, #9852, #10367
   if (prefs_->GetBoolean(kGoogleLoginControlType)) {
-    const auto google_auth_rule = Rule(
-        ContentSettingsPattern::FromString(kGoogleAuthPattern),
-        ContentSettingsPattern::Wildcard(),
-        base::Value::FromUniquePtrValue(
-                         ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-                     base::Time(), SessionModel::Durable);
-    rules.emplace_back(CloneRule(google_auth_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(google_auth_rule));
-
-    const auto firebase_rule = Rule(
-        ContentSettingsPattern::FromString(kFirebasePattern),
-        ContentSettingsPattern::Wildcard(),
-        base::Value::FromUniquePtrValue(
-            ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-        base::Time(), SessionModel::Durable);
-    rules.emplace_back(CloneRule(firebase_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(firebase_rule));
+    for (const char* pattern : {kGoogleAuthPattern, kFirebasePattern}) {
+      brave_rules.emplace_back(
+          ContentSettingsPattern::FromString(pattern),
+          ContentSettingsPattern::Wildcard(),
+          base::Value::FromUniquePtrValue(
+              ContentSettingToValue(CONTENT_SETTING_ALLOW)),
+          base::Time(), SessionModel::Durable);
+      rules.emplace_back(CloneRule(brave_rules.back()));
+    }
   }
   // non-pref based exceptions should go in the cookie_settings_base.cc
   // chromium_src override
@@ -483,7 +539,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
       ContentSettingsType::COOKIES,
       incognito);
   while (chromium_cookies_iterator && chromium_cookies_iterator->HasNext()) {
-    rules.emplace_back(CloneRule(chromium_cookies_iterator->Next()));
+    rules.emplace_back(chromium_cookies_iterator->Next());
   }
   chromium_cookies_iterator.reset();
 
@@ -493,7 +549,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   // collect shield rules
   std::vector<Rule> shield_rules;
   while (brave_shields_iterator && brave_shields_iterator->HasNext()) {
-    shield_rules.emplace_back(CloneRule(brave_shields_iterator->Next()));
+    shield_rules.emplace_back(brave_shields_iterator->Next());
   }
 
   brave_shields_iterator.reset();
@@ -503,13 +559,15 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
       ContentSettingsType::BRAVE_COOKIES, incognito);
 
   // Matching cookie rules against shield rules.
+  const ShieldRulesIndex shield_rules_index(shield_rules);
   while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
     auto rule = brave_cookies_iterator->Next();
-    if (IsActive(rule, shield_rules)) {
-      rules.emplace_back(CloneRule(rule, true));
-      brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
+    if (shield_rules_index.IsActive(rule)) {
+      brave_rules.emplace_back(CloneRule(rule, true));
+      rules.emplace_back(CloneRule(brave_rules.back()));
     }
   }
+  brave_cookies_iterator.reset();
 
   // Adding shields down rules (they always override cookie rules).
   for (const auto& shield_rule : shield_rules) {
@@ -519,69 +577,59 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
 
     // Shields down.
     if (ValueToContentSetting(&shield_rule.value) == CONTENT_SETTING_BLOCK) {
-      rules.emplace_back(
-          Rule(ContentSettingsPattern::Wildcard(),
-               shield_rule.primary_pattern,
-               base::Value::FromUniquePtrValue(
-                   ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-               base::Time(), SessionModel::Durable));
-      brave_cookie_rules_[incognito].emplace_back(
-          Rule(ContentSettingsPattern::Wildcard(),
-               shield_rule.primary_pattern,
-               base::Value::FromUniquePtrValue(
-                   ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-               base::Time(), SessionModel::Durable));
+      brave_rules.emplace_back(
+          ContentSettingsPattern::Wildcard(), shield_rule.primary_pattern,
+          base::Value::FromUniquePtrValue(
+              ContentSettingToValue(CONTENT_SETTING_ALLOW)),
+          base::Time(), SessionModel::Durable);
+      rules.emplace_back(CloneRule(brave_rules.back()));
     }
   }
 
+  {
+    base::AutoLock lock(cookie_rules_lock_);
+    cookie_rules_[incognito] = base::MakeRefCounted<RuleList>(std::move(rules));
+  }
+
+  // Notify brave cookie changes as ContentSettingsType::COOKIES
+  if (!initialized_ || (content_type != ContentSettingsType::BRAVE_COOKIES &&
+                        content_type != ContentSettingsType::BRAVE_SHIELDS)) {
+    return;
+  }
+
   // get the list of changes
+  std::unordered_set<std::string> old_rule_keys;
+  for (const auto& old_rule : old_rules)
+    old_rule_keys.insert(GetRuleKey(old_rule));
+
   std::vector<Rule> brave_cookie_updates;
-  for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
+  std::unordered_set<std::string> new_patterns_keys;
+  for (const auto& new_rule : brave_rules) {
+    new_patterns_keys.insert(GetPatternsKey(new_rule));
+    // we want an exact match here because any change to the rule
+    // is an update
+    if (!old_rule_keys.count(GetRuleKey(new_rule)))
       brave_cookie_updates.emplace_back(CloneRule(new_rule));
-    }
   }
 
   // find any removed rules
   for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
+    // we only care about the patterns here because we're looking
+    // for deleted rules, not changed rules
+    if (!new_patterns_keys.count(GetPatternsKey(old_rule))) {
       brave_cookie_updates.emplace_back(
           Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
                base::Value(), old_rule.expiration, old_rule.session_model));
     }
   }
 
-  // Notify brave cookie changes as ContentSettingsType::COOKIES
-  if (initialized_ && (content_type == ContentSettingsType::BRAVE_COOKIES ||
-                       content_type == ContentSettingsType::BRAVE_SHIELDS)) {
-    // PostTask here to avoid content settings autolock DCHECK
-    base::PostTask(
-        FROM_HERE,
-        {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
-        base::BindOnce(&BravePrefProvider::NotifyChanges,
-                       weak_factory_.GetWeakPtr(),
-                       std::move(brave_cookie_updates), incognito));
-  }
+  // PostTask here to avoid content settings autolock DCHECK
+  base::PostTask(
+      FROM_HERE,
+      {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&BravePrefProvider::NotifyChanges,
+                     weak_factory_.GetWeakPtr(),
+                     std::move(brave_cookie_updates), incognito));
 }
 
 void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
@@ -11,7 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/content_settings_pref_provider.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -43,6 +45,8 @@ class BravePrefProvider : public PrefProvider,
       bool incognito) const override;
 
  private:
+  using RuleList = base::RefCountedData<std::vector<Rule>>;
+
   friend class BravePrefProviderTest;
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest, TestShieldsSettingsMigration);
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest,
@@ -63,6 +67,7 @@ class BravePrefProvider : public PrefProvider,
   void MigrateShieldsSettingsV1ToV2();
   void MigrateShieldsSettingsV1ToV2ForOneType(ContentSettingsType content_type);
   void UpdateCookieRules(ContentSettingsType content_type, bool incognito);
+  scoped_refptr<const RuleList> GetCookieRules(bool incognito) const;
   void OnCookieSettingsChanged(ContentSettingsType content_type);
   void NotifyChanges(const std::vector<Rule>& rules, bool incognito);
   bool SetWebsiteSettingInternal(
@@ -78,7 +83,11 @@ class BravePrefProvider : public PrefProvider,
                                ContentSettingsType content_type) override;
   void OnCookiePrefsChanged(const std::string& pref);
 
-  std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
+  // Immutable snapshots of the effective cookie rules. Rule iterators share
+  // a snapshot instead of copying it, a new one is built on every update.
+  mutable base::Lock cookie_rules_lock_;
+  std::map<bool /* is_incognito */, scoped_refptr<const RuleList>>
+      cookie_rules_;
   std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
 
   bool initialized_;
@@ -8,6 +8,8 @@
 
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -225,6 +227,43 @@ class ShieldsScriptSetting : public ShieldsSetting {
   }
 };
 
+// Adds a cookie block exception for |site_count| sites, with shields down
+// for every 10th site.
+void AddCookieSiteExceptions(PrefService* pref_service, int site_count) {
+  // Skip the migration, the patterns below are already in the new format.
+  pref_service->SetInteger(kBraveShieldsSettingsVersion, 2);
+  prefs::ScopedDictionaryPrefUpdate shields_update(
+      pref_service,
+      GetShieldsSettingUserPrefsPath(brave_shields::kBraveShields));
+  prefs::ScopedDictionaryPrefUpdate cookies_update(
+      pref_service, GetShieldsSettingUserPrefsPath(brave_shields::kCookies));
+  for (int i = 0; i < site_count; ++i) {
+    const std::string patterns =
+        base::StringPrintf("[*.]site%d.example.com,*", i);
+    auto cookie_setting = std::make_unique<base::DictionaryValue>();
+    cookie_setting->SetInteger(kSettingPath, CONTENT_SETTING_BLOCK);
+    cookies_update->SetDictionaryWithoutPathExpansion(
+        patterns, std::move(cookie_setting));
+    if (i % 10 == 0) {
+      auto shields_setting = std::make_unique<base::DictionaryValue>();
+      shields_setting->SetInteger(kSettingPath, CONTENT_SETTING_BLOCK);
+      shields_update->SetDictionaryWithoutPathExpansion(
+          patterns, std::move(shields_setting));
+    }
+  }
+}
+
+size_t CountCookieRules(const BravePrefProvider& provider) {
+  size_t count = 0;
+  auto rule_iterator =
+      provider.GetRuleIterator(ContentSettingsType::COOKIES, false);
+  while (rule_iterator->HasNext()) {
+    rule_iterator->Next();
+    ++count;
+  }
+  return count;
+}
+
 }  // namespace
 
 class BravePrefProviderTest : public testing::Test {
@@ -524,4 +563,59 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationFromUnknownSettings) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, CookieRulesWithManySiteExceptions) {
+  constexpr int kSiteCount = 10000;
+  PrefService* pref_service = testing_profile()->GetPrefs();
+  AddCookieSiteExceptions(pref_service, kSiteCount);
+  const size_t google_rules_count =
+      pref_service->GetBoolean(kGoogleLoginControlType) ? 2 : 0;
+
+  BravePrefProvider provider(pref_service, false /* incognito */,
+                             true /* store_last_modified */,
+                             false /* restore_session */);
+
+  // Cookie exceptions of sites with shields down are inactive, but each of
+  // those sites gets an allow rule instead.
+  EXPECT_EQ(CountCookieRules(provider), kSiteCount + google_rules_count);
+
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]site1.example.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  EXPECT_EQ(CountCookieRules(provider), kSiteCount + google_rules_count);
+
+  provider.ShutdownOnUIThread();
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST_F(BravePrefProviderTest, DISABLED_BenchmarkCookieRules) {
+  constexpr int kSiteCount = 10000;
+  PrefService* pref_service = testing_profile()->GetPrefs();
+  AddCookieSiteExceptions(pref_service, kSiteCount);
+
+  base::ElapsedTimer load_timer;
+  BravePrefProvider provider(pref_service, false /* incognito */,
+                             true /* store_last_modified */,
+                             false /* restore_session */);
+  const base::TimeDelta load_time = load_timer.Elapsed();
+
+  base::ElapsedTimer iterate_timer;
+  constexpr int kIterations = 100;
+  for (int i = 0; i < kIterations; ++i)
+    CountCookieRules(provider);
+  const base::TimeDelta iterate_time = iterate_timer.Elapsed() / kIterations;
+
+  base::ElapsedTimer update_timer;
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]site1.example.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  const base::TimeDelta update_time = update_timer.Elapsed();
+
+  LOG(INFO) << kSiteCount << " site exceptions: load " << load_time
+            << ", iterate " << iterate_time << ", update " << update_time;
+
+  provider.ShutdownOnUIThread();
+}
+
 }  //  namespace content_settings
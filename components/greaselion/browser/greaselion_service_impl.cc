@@ -6,7 +6,10 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,12 +18,17 @@
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
+#include "base/containers/contains.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -33,6 +41,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
@@ -51,28 +60,147 @@ namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
+// Converted extensions are kept in subdirectories of this directory named
+// after their cache key.
+constexpr char kCacheDirectoryName[] = "Cache";
+
+// Bump this whenever the layout of converted extensions changes, so that
+// extensions cached by older versions are regenerated.
+constexpr char kCacheFormatVersion[] = "1";
+
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a
+// public key.
+std::string GetPublicKeyForRule(const greaselion::GreaselionRule& rule) {
+  char raw[crypto::kSHA256Length] = {0};
+  std::string key;
+  std::string script_name = rule.name();
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
+                             raw,
+                             crypto::kSHA256Length);
+  } else {
+    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
+                             raw,
+                             crypto::kSHA256Length);
+  }
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+void UpdateHash(crypto::SecureHash* hash, base::StringPiece value) {
+  // Length-prefix every value so that adjacent values can't run together.
+  const uint64_t size = value.size();
+  hash->Update(&size, sizeof(size));
+  hash->Update(value.data(), value.size());
+}
+
+// Computes the key a rule's converted extension is cached under. The key
+// covers everything that ends up in the extension: the rule itself, its
+// identity and the contents of its scripts and messages. Script and messages
+// paths live under the versioned component install directory, so the key
+// also changes with the component version. Returns an empty string if a file
+// referenced by the rule can't be read.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-base::Optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
-    const greaselion::GreaselionRule& rule,
+std::string ComputeCacheKey(const greaselion::GreaselionRule& rule) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  UpdateHash(hash.get(), kCacheFormatVersion);
+  UpdateHash(hash.get(), rule.name());
+  UpdateHash(hash.get(), GetPublicKeyForRule(rule));
+  UpdateHash(hash.get(), rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    UpdateHash(hash.get(), url_pattern);
+
+  std::string contents;
+  for (const auto& script : rule.scripts()) {
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+                 << script.LossyDisplayName();
+      return std::string();
+    }
+    UpdateHash(hash.get(), script.AsUTF8Unsafe());
+    UpdateHash(hash.get(), contents);
+  }
+
+  if (!rule.messages().empty()) {
+    UpdateHash(hash.get(), rule.messages().AsUTF8Unsafe());
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    for (const auto& path : message_files) {
+      if (!base::ReadFileToString(path, &contents)) {
+        LOG(ERROR) << "Could not read Greaselion messages at path: "
+                   << path.LossyDisplayName();
+        return std::string();
+      }
+      UpdateHash(hash.get(), path.AsUTF8Unsafe());
+      UpdateHash(hash.get(), contents);
+    }
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)));
+}
+
+// Computes the cache key of every rule and deletes cached extensions that no
+// longer belong to any of them. The returned keys are in the same order as
+// |rules|.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::vector<std::string> ComputeCacheKeysOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules,
     const base::FilePath& install_dir) {
+  std::vector<std::string> cache_keys;
+  cache_keys.reserve(rules.size());
+  for (const auto& rule : rules)
+    cache_keys.push_back(ComputeCacheKey(rule));
+
+  const std::set<std::string> live_keys(cache_keys.begin(), cache_keys.end());
+  base::FileEnumerator enumerator(
+      install_dir.AppendASCII(kCacheDirectoryName), false,
+      base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!base::Contains(live_keys, path.BaseName().AsUTF8Unsafe()))
+      base::DeletePathRecursively(path);
+  }
+
+  return cache_keys;
+}
+
+// Wraps a Greaselion rule in a component and writes it as an unpacked
+// extension to |extension_dir|. The extension is assembled in a temporary
+// directory and moved into place once complete, so |extension_dir| never
+// holds a partially written extension.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+bool WriteGreaselionExtension(const greaselion::GreaselionRule& rule,
+                              const base::FilePath& install_dir,
+                              const base::FilePath& extension_dir) {
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(install_dir);
   if (install_temp_dir.empty()) {
     LOG(ERROR) << "Could not get path to profile temp directory";
-    return base::nullopt;
+    return false;
   }
 
   base::ScopedTempDir temp_dir;
   if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
     LOG(ERROR) << "Could not create Greaselion temp directory";
-    return base::nullopt;
+    return false;
   }
 
   // Create the manifest
@@ -82,33 +210,11 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // see kModernManifestVersion in src/extensions/common/extension.cc
   root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
 
-  // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
-  char raw[crypto::kSHA256Length] = {0};
-  std::string key;
-  std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  }
-  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
-
-  root->SetStringPath(extensions::manifest_keys::kName, script_name);
+  root->SetStringPath(extensions::manifest_keys::kName, rule.name());
   root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
   root->SetStringPath(extensions::manifest_keys::kDescription, "");
-  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
+  root->SetStringPath(extensions::manifest_keys::kPublicKey,
+                      GetPublicKeyForRule(rule));
   root->SetStringPath("incognito",
                       extensions::manifest_values::kIncognitoNotAllowed);
 
@@ -150,7 +256,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return base::nullopt;
+    return false;
   }
 
   // Copy the messages directory to our extension directory.
@@ -160,7 +266,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             temp_dir.GetPath().AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return base::nullopt;
+      return false;
     }
   }
 
@@ -170,24 +276,57 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
                         temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return base::nullopt;
+      return false;
     }
   }
 
+  if (!base::CreateDirectory(extension_dir.DirName())) {
+    LOG(ERROR) << "Could not create Greaselion cache directory";
+    return false;
+  }
+
+  base::FilePath temp_path = temp_dir.Take();
+  if (!base::Move(temp_path, extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension into the cache";
+    base::DeletePathRecursively(temp_path);
+    return false;
+  }
+
+  return true;
+}
+
+// Loads the extension for a Greaselion rule from the on-disk cache,
+// converting the rule first if it isn't cached yet. Returns a valid extension
+// that the caller should take ownership of, or nullptr.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+scoped_refptr<Extension> LoadGreaselionExtensionOnTaskRunner(
+    const greaselion::GreaselionRule& rule,
+    const std::string& cache_key,
+    const base::FilePath& install_dir) {
+  base::FilePath extension_dir =
+      install_dir.AppendASCII(kCacheDirectoryName).AppendASCII(cache_key);
+  if (!base::DirectoryExists(extension_dir) &&
+      !WriteGreaselionExtension(rule, install_dir, extension_dir)) {
+    return nullptr;
+  }
+
   std::string error;
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS,
       &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
-    return base::nullopt;
+    // Don't keep a broken extension around, so the next attempt regenerates
+    // it.
+    base::DeletePathRecursively(extension_dir);
+    return nullptr;
   }
 
-  // Take ownership of this temporary directory so it's deleted when
-  // the service exits
-  return std::make_pair(extension, std::move(temp_dir));
+  return extension;
 }
+
 }  // namespace
 
 namespace greaselion {
@@ -238,74 +377,111 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
-    CreateAndInstallExtensions();
-    return;
-  }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
-    extension_service_->UnloadExtension(
-        id, extensions::UnloadedExtensionReason::UPDATE);
+  // Cache keys depend on the contents of the rules' files, so they are
+  // computed on the extension file task runner, which was passed in in the
+  // constructor.
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    rules.push_back(*rule);
   }
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ComputeCacheKeysOnTaskRunner, rules,
+                     install_directory_),
+      base::BindOnce(&GreaselionServiceImpl::OnCacheKeysComputed,
+                     weak_factory_.GetWeakPtr(), rules));
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+void GreaselionServiceImpl::OnCacheKeysComputed(
+    std::vector<GreaselionRule> rules,
+    std::vector<std::string> cache_keys) {
   DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), cache_keys.size());
   all_rules_installed_successfully_ = true;
   pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+
+  // Work out which rules should be installed in the current state, and under
+  // which key.
+  std::map<std::string, std::string> wanted_rules;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (!rules[i].Matches(state_, browser_version_) ||
+        rules[i].has_unknown_preconditions()) {
+      continue;
+    }
+    if (cache_keys[i].empty()) {
+      all_rules_installed_successfully_ = false;
+      continue;
     }
+    wanted_rules[rules[i].name()] = cache_keys[i];
   }
-  if (!pending_installs_) {
-    // no rules match, nothing else to do
-    MaybeNotifyObservers();
-    return;
+
+  // Only unload extensions whose rule no longer applies or has changed.
+  // OnExtensionUnloaded forgets about them.
+  std::vector<extensions::ExtensionId> stale_extensions;
+  for (const auto& installed : installed_rules_) {
+    auto wanted = wanted_rules.find(installed.first);
+    if (wanted == wanted_rules.end() ||
+        wanted->second != installed.second.cache_key) {
+      stale_extensions.push_back(installed.second.extension_id);
+    }
+  }
+  for (const auto& id : stale_extensions) {
+    extension_service_->UnloadExtension(
+        id, extensions::UnloadedExtensionReason::UPDATE);
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
+
+  // Drop converted extensions that no current rule refers to.
+  std::set<std::string> live_keys(cache_keys.begin(), cache_keys.end());
+  base::EraseIf(extension_cache_, [&live_keys](const auto& entry) {
+    return !base::Contains(live_keys, entry.first);
+  });
+
+  // Install the rules that aren't installed yet, reusing an extension that
+  // was converted earlier when possible.
+  for (const GreaselionRule& rule : rules) {
+    auto wanted = wanted_rules.find(rule.name());
+    if (wanted == wanted_rules.end() ||
+        base::Contains(installed_rules_, rule.name())) {
+      continue;
     }
+    pending_installs_ += 1;
+    auto cached = extension_cache_.find(wanted->second);
+    if (cached != extension_cache_.end()) {
+      PostConvert(rule.name(), wanted->second, cached->second);
+      continue;
+    }
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&LoadGreaselionExtensionOnTaskRunner, rule,
+                       wanted->second, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule.name(),
+                       wanted->second));
   }
+
+  // Nothing else to do if everything that should be installed already is.
+  MaybeNotifyObservers();
 }
 
 void GreaselionServiceImpl::PostConvert(
-    base::Optional<GreaselionConvertedExtension> converted_extension) {
-  if (!converted_extension) {
+    const std::string& rule_name,
+    const std::string& cache_key,
+    scoped_refptr<extensions::Extension> extension) {
+  if (!extension) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    extension_cache_[cache_key] = extension;
+    installed_rules_[rule_name] = {cache_key, extension->id()};
+    greaselion_extensions_.push_back(extension->id());
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+                                  std::move(extension)));
   }
 }
 
@@ -339,10 +515,9 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
-    // It's time!
-    CreateAndInstallExtensions();
-  }
+  base::EraseIf(installed_rules_, [extension](const auto& installed) {
+    return installed.second.extension_id == extension->id();
+  });
 }
 
 void GreaselionServiceImpl::AddObserver(Observer* observer) {
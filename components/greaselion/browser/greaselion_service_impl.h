@@ -13,11 +13,11 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
@@ -35,8 +35,11 @@ class ExtensionSystem;
 
 namespace greaselion {
 
-class GreaselionDownloadService;
-
+// Installs a component extension for every Greaselion rule whose
+// preconditions match the current state. Converted extensions are cached on
+// disk under a key derived from the rule and its files, and in memory for the
+// lifetime of the service, so that a feature toggle only loads or unloads the
+// rules it affects.
 class GreaselionServiceImpl : public GreaselionService {
  public:
   explicit GreaselionServiceImpl(
@@ -63,14 +66,18 @@ class GreaselionServiceImpl : public GreaselionService {
                            const extensions::Extension* extension,
                            extensions::UnloadedExtensionReason reason) override;
 
-  using GreaselionConvertedExtension =
-      std::pair<scoped_refptr<extensions::Extension>, base::ScopedTempDir>;
-
  private:
+  struct InstalledRule {
+    std::string cache_key;
+    extensions::ExtensionId extension_id;
+  };
+
   void SetBrowserVersionForTesting(const base::Version& version) override;
-  void CreateAndInstallExtensions();
-  void PostConvert(
-      base::Optional<GreaselionConvertedExtension> converted_extension);
+  void OnCacheKeysComputed(std::vector<GreaselionRule> rules,
+                           std::vector<std::string> cache_keys);
+  void PostConvert(const std::string& rule_name,
+                   const std::string& cache_key,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -87,7 +94,11 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Installed extensions by rule name.
+  std::map<std::string, InstalledRule> installed_rules_;
+  // Converted extensions by cache key.
+  std::map<std::string, scoped_refptr<extensions::Extension>>
+      extension_cache_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
@@ -20,5 +20,10 @@ const base::Feature kIpfsFeature{
 #endif
 };
 
+// Uploads folder contents file by file with a bounded number of parallel
+// requests instead of a single multipart request for the whole tree.
+const base::Feature kIpfsParallelFolderImport{
+    "IpfsParallelFolderImport", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace ipfs
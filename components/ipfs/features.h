@@ -14,6 +14,7 @@ namespace ipfs {
 namespace features {
 
 extern const base::Feature kIpfsFeature;
+extern const base::Feature kIpfsParallelFolderImport;
 
 }  // namespace features
 }  // namespace ipfs
@@ -38,6 +38,10 @@ struct ImportedData {
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
 
+// Reports how many bytes of the import were uploaded to the node so far.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(int64_t uploaded_bytes, int64_t total_bytes)>;
+
 }  // namespace ipfs
 
 #endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IMPORTED_DATA_H_
@@ -0,0 +1,407 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_folder_import_worker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_json_parser.h"
+#include "brave/components/ipfs/ipfs_network_utils.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/url_util.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace {
+
+// MFS commands reply with small JSON objects.
+constexpr size_t kMaxFolderResponseSize = 64 * 1024;
+
+int GetResponseCode(const network::SimpleURLLoader* url_loader) {
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    return url_loader->ResponseInfo()->headers->response_code();
+  return -1;
+}
+
+ipfs::IpfsFolderImportWorker::FolderContents EnumerateFolder(
+    const base::FilePath& folder_path) {
+  ipfs::IpfsFolderImportWorker::FolderContents contents;
+  contents.exists = base::DirectoryExists(folder_path);
+  if (!contents.exists)
+    return contents;
+
+  base::FileEnumerator file_enum(
+      folder_path, true,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath enum_path = file_enum.Next(); !enum_path.empty();
+       enum_path = file_enum.Next()) {
+    // Skip symlinks.
+    if (base::IsLink(enum_path))
+      continue;
+    base::FilePath relative_path;
+    if (!folder_path.AppendRelativePath(enum_path, &relative_path))
+      continue;
+    std::string relative =
+        relative_path.NormalizePathSeparatorsTo('/').AsUTF8Unsafe();
+    const auto& info = file_enum.GetInfo();
+    if (info.IsDirectory()) {
+      contents.directories.push_back(std::move(relative));
+      continue;
+    }
+    ipfs::IpfsFolderImportWorker::FileEntry entry;
+    entry.path = enum_path;
+    entry.relative_path = std::move(relative);
+    entry.size = info.GetSize();
+    contents.total_size += entry.size;
+    contents.files.push_back(std::move(entry));
+  }
+  std::sort(contents.directories.begin(), contents.directories.end());
+  return contents;
+}
+
+}  // namespace
+
+namespace ipfs {
+
+// Uploads a single file and picks its hash out of the streamed NDJSON
+// response of /api/v0/add.
+class IpfsFolderImportWorker::FileUpload
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  using CompletedCallback =
+      base::OnceCallback<void(bool success, const std::string& hash)>;
+
+  FileUpload(std::unique_ptr<network::SimpleURLLoader> url_loader,
+             const std::string& filename,
+             CompletedCallback callback)
+      : url_loader_(std::move(url_loader)),
+        filename_(filename),
+        callback_(std::move(callback)) {}
+  ~FileUpload() override = default;
+
+  FileUpload(const FileUpload&) = delete;
+  FileUpload& operator=(const FileUpload&) = delete;
+
+  void Start(network::mojom::URLLoaderFactory* url_loader_factory) {
+    url_loader_->DownloadAsStream(url_loader_factory, this);
+  }
+
+  int64_t uploaded_bytes() const { return uploaded_bytes_; }
+  void set_uploaded_bytes(int64_t bytes) { uploaded_bytes_ = bytes; }
+
+  // network::SimpleURLLoaderStreamConsumer
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    buffer_.append(string_piece.data(), string_piece.size());
+    size_t start = 0;
+    for (size_t end = buffer_.find('\n', start); end != std::string::npos;
+         end = buffer_.find('\n', start)) {
+      ParseLine(base::StringPiece(buffer_).substr(start, end - start));
+      start = end + 1;
+    }
+    buffer_.erase(0, start);
+    std::move(resume).Run();
+  }
+
+  void OnComplete(bool success) override {
+    ParseLine(buffer_);
+    buffer_.clear();
+    int error_code = url_loader_->NetError();
+    int response_code = GetResponseCode(url_loader_.get());
+    success = success && error_code == net::OK &&
+              response_code == net::HTTP_OK && !hash_.empty();
+    if (!success) {
+      VLOG(1) << "error_code:" << error_code
+              << " response_code:" << response_code;
+    }
+    // The owner deletes this object from the callback, so let the loader
+    // unwind first.
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback_), success, hash_));
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override {
+    buffer_.clear();
+    hash_.clear();
+    std::move(start_retry).Run();
+  }
+
+ private:
+  void ParseLine(base::StringPiece line) {
+    line = base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+    if (line.empty() || line.front() != '{' || line.back() != '}')
+      return;
+    ipfs::ImportedData item;
+    if (!IPFSJSONParser::GetImportResponseFromJSON(line.as_string(), &item) ||
+        item.hash.empty()) {
+      return;
+    }
+    if (hash_.empty() || item.filename == filename_)
+      hash_ = item.hash;
+  }
+
+  std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  std::string filename_;
+  CompletedCallback callback_;
+  std::string buffer_;
+  std::string hash_;
+  int64_t uploaded_bytes_ = 0;
+};
+
+IpfsFolderImportWorker::FolderContents::FolderContents() = default;
+IpfsFolderImportWorker::FolderContents::~FolderContents() = default;
+IpfsFolderImportWorker::FolderContents::FolderContents(FolderContents&&) =
+    default;
+IpfsFolderImportWorker::FolderContents&
+IpfsFolderImportWorker::FolderContents::operator=(FolderContents&&) = default;
+
+IpfsFolderImportWorker::IpfsFolderImportWorker(
+    content::BrowserContext* context,
+    const GURL& endpoint,
+    ImportCompletedCallback callback,
+    ImportProgressCallback progress_callback,
+    const base::FilePath& folder_path,
+    const std::string& key)
+    : IpfsImportWorkerBase(context, endpoint, std::move(callback), key),
+      folder_path_(folder_path),
+      progress_callback_(std::move(progress_callback)),
+      weak_factory_(this) {
+  DCHECK(context);
+  DCHECK(endpoint.is_valid());
+  GetImportedData()->filename = folder_path.BaseName().MaybeAsASCII();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EnumerateFolder, folder_path_),
+      base::BindOnce(&IpfsFolderImportWorker::OnFolderEnumerated,
+                     weak_factory_.GetWeakPtr()));
+}
+
+IpfsFolderImportWorker::~IpfsFolderImportWorker() = default;
+
+void IpfsFolderImportWorker::OnFolderEnumerated(FolderContents contents) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!contents.exists)
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+  contents_ = std::move(contents);
+  NotifyProgress();
+  if (contents_.files.empty()) {
+    AssembleFolder();
+    return;
+  }
+  MaybeStartUploads();
+}
+
+void IpfsFolderImportWorker::MaybeStartUploads() {
+  while (active_uploads_.size() < kMaxParallelUploads &&
+         next_upload_ < contents_.files.size()) {
+    size_t index = next_upload_++;
+    const FileEntry& file = contents_.files[index];
+    // Reserve the slot while the request body is being prepared.
+    active_uploads_[index] = nullptr;
+    CreateRequestForFile(
+        file.path,
+        content::BrowserContext::GetBlobStorageContext(GetBrowserContext()),
+        kFileMimeType, file.path.BaseName().AsUTF8Unsafe(),
+        base::BindOnce(&IpfsFolderImportWorker::OnUploadRequestCreated,
+                       weak_factory_.GetWeakPtr(), index),
+        file.size);
+  }
+}
+
+void IpfsFolderImportWorker::OnUploadRequestCreated(
+    size_t index,
+    std::unique_ptr<network::ResourceRequest> request) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!request)
+    return OnUploadCompleted(index, false, std::string());
+
+  GURL url = net::AppendQueryParameter(
+      GetServerEndpoint().Resolve(kImportAddPath), "stream-channels", "true");
+  url = net::AppendQueryParameter(url, "pin", "false");
+  url = net::AppendQueryParameter(url, "progress", "false");
+
+  auto url_loader = CreateURLLoader(url, "POST", std::move(request));
+  url_loader->SetOnUploadProgressCallback(
+      base::BindRepeating(&IpfsFolderImportWorker::OnUploadProgress,
+                          weak_factory_.GetWeakPtr(), index));
+  auto upload = std::make_unique<FileUpload>(
+      std::move(url_loader),
+      contents_.files[index].path.BaseName().AsUTF8Unsafe(),
+      base::BindOnce(&IpfsFolderImportWorker::OnUploadCompleted,
+                     weak_factory_.GetWeakPtr(), index));
+  FileUpload* upload_ptr = upload.get();
+  active_uploads_[index] = std::move(upload);
+  upload_ptr->Start(GetUrlLoaderFactory().get());
+}
+
+void IpfsFolderImportWorker::OnUploadProgress(size_t index,
+                                              uint64_t position,
+                                              uint64_t total) {
+  auto it = active_uploads_.find(index);
+  if (it == active_uploads_.end() || !it->second)
+    return;
+  // |position| includes multipart headers, count file bytes only.
+  it->second->set_uploaded_bytes(std::min(
+      static_cast<int64_t>(position), contents_.files[index].size));
+  NotifyProgress();
+}
+
+void IpfsFolderImportWorker::OnUploadCompleted(size_t index,
+                                               bool success,
+                                               const std::string& hash) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  active_uploads_.erase(index);
+  if (!success) {
+    // Cancels the remaining uploads, the owner deletes us when notified.
+    active_uploads_.clear();
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+  }
+  FileEntry& file = contents_.files[index];
+  file.hash = hash;
+  completed_bytes_ += file.size;
+  completed_uploads_++;
+  NotifyProgress();
+
+  if (completed_uploads_ == contents_.files.size()) {
+    AssembleFolder();
+    return;
+  }
+  MaybeStartUploads();
+}
+
+void IpfsFolderImportWorker::NotifyProgress() {
+  if (!progress_callback_)
+    return;
+  int64_t uploaded_bytes = completed_bytes_;
+  for (const auto& upload : active_uploads_) {
+    if (upload.second)
+      uploaded_bytes += upload.second->uploaded_bytes();
+  }
+  progress_callback_.Run(uploaded_bytes, contents_.total_size);
+}
+
+void IpfsFolderImportWorker::AssembleFolder() {
+  DCHECK(!folder_request_loader_);
+  ImportedData* data = GetImportedData();
+  data->directory = GetImportDirectory();
+  folder_mfs_path_ = data->directory + data->filename;
+
+  auto add_make_directory = [this](const std::string& path) {
+    GURL url = net::AppendQueryParameter(
+        GetServerEndpoint().Resolve(kImportMakeDirectoryPath), "parents",
+        "true");
+    url = net::AppendQueryParameter(url, "arg", path);
+    folder_requests_.emplace(url, IPFS_IMPORT_ERROR_MKDIR_FAILED);
+  };
+  add_make_directory(folder_mfs_path_);
+  // Directories are sorted, so only the deepest ones need to be created
+  // explicitly, their parents are created along the way.
+  const auto& directories = contents_.directories;
+  for (size_t i = 0; i < directories.size(); ++i) {
+    const std::string& directory = directories[i];
+    if (i + 1 < directories.size() &&
+        base::StartsWith(directories[i + 1], directory + "/",
+                         base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+    add_make_directory(folder_mfs_path_ + "/" + directory);
+  }
+  for (const auto& file : contents_.files) {
+    GURL url = net::AppendQueryParameter(
+        GetServerEndpoint().Resolve(kImportCopyPath), "arg",
+        "/ipfs/" + file.hash);
+    url = net::AppendQueryParameter(url, "arg",
+                                    folder_mfs_path_ + "/" + file.relative_path);
+    folder_requests_.emplace(url, IPFS_IMPORT_ERROR_MOVE_FAILED);
+  }
+  RunNextFolderRequest();
+}
+
+void IpfsFolderImportWorker::RunNextFolderRequest() {
+  DCHECK(!folder_request_loader_);
+  if (folder_requests_.empty()) {
+    ResolveFolderHash();
+    return;
+  }
+  auto request = std::move(folder_requests_.front());
+  folder_requests_.pop();
+
+  folder_request_loader_ = CreateURLLoader(request.first, "POST");
+  folder_request_loader_->DownloadToString(
+      GetUrlLoaderFactory().get(),
+      base::BindOnce(&IpfsFolderImportWorker::OnFolderRequestCompleted,
+                     weak_factory_.GetWeakPtr(), request.second),
+      kMaxFolderResponseSize);
+}
+
+void IpfsFolderImportWorker::OnFolderRequestCompleted(
+    ImportState error_state,
+    std::unique_ptr<std::string> response_body) {
+  bool success = IsLastRequestSucceeded();
+  folder_request_loader_.reset();
+  if (!success) {
+    VLOG(1) << "response_body:" << (response_body ? *response_body : "");
+    return NotifyImportCompleted(error_state);
+  }
+  RunNextFolderRequest();
+}
+
+void IpfsFolderImportWorker::ResolveFolderHash() {
+  DCHECK(!folder_request_loader_);
+  GURL url = net::AppendQueryParameter(
+      GetServerEndpoint().Resolve(kImportStatPath), "arg", folder_mfs_path_);
+  folder_request_loader_ = CreateURLLoader(url, "POST");
+  folder_request_loader_->DownloadToString(
+      GetUrlLoaderFactory().get(),
+      base::BindOnce(&IpfsFolderImportWorker::OnFolderHashResolved,
+                     weak_factory_.GetWeakPtr()),
+      kMaxFolderResponseSize);
+}
+
+void IpfsFolderImportWorker::OnFolderHashResolved(
+    std::unique_ptr<std::string> response_body) {
+  bool success = IsLastRequestSucceeded() && response_body;
+  folder_request_loader_.reset();
+  // files/stat replies with the same Hash field as add.
+  ImportedData stat;
+  if (!success ||
+      !IPFSJSONParser::GetImportResponseFromJSON(*response_body, &stat) ||
+      stat.hash.empty()) {
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+  }
+  ImportedData* data = GetImportedData();
+  data->hash = stat.hash;
+  data->size = contents_.total_size;
+  PublishContentOrComplete();
+}
+
+bool IpfsFolderImportWorker::IsLastRequestSucceeded() const {
+  DCHECK(folder_request_loader_);
+  int error_code = folder_request_loader_->NetError();
+  int response_code = GetResponseCode(folder_request_loader_.get());
+  if (error_code != net::OK || response_code != net::HTTP_OK) {
+    VLOG(1) << "error_code:" << error_code
+            << " response_code:" << response_code;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace ipfs
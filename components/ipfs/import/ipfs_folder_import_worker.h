@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_WORKER_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_WORKER_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/queue.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/ipfs/import/imported_data.h"
+#include "brave/components/ipfs/import/ipfs_import_worker_base.h"
+#include "url/gurl.h"
+
+namespace network {
+struct ResourceRequest;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace ipfs {
+
+// Imports a local folder into ipfs file by file:
+//   1. Enumerates the folder on a blocking thread.
+//   2. Uploads files using IPFS api (/api/v0/add), at most
+//      |kMaxParallelUploads| at a time, parsing the NDJSON response
+//      while it streams in.
+//   3. Recreates the folder tree in the imports directory using IPFS api
+//      (/api/v0/files/mkdir and /api/v0/files/cp).
+//   4. Resolves the folder hash using IPFS api (/api/v0/files/stat) and
+//      publishes it if a key was passed.
+// Upload progress is reported through |progress_callback|.
+class IpfsFolderImportWorker : public IpfsImportWorkerBase {
+ public:
+  static constexpr size_t kMaxParallelUploads = 4;
+
+  struct FileEntry {
+    base::FilePath path;
+    // Path relative to the imported folder, '/' separated.
+    std::string relative_path;
+    int64_t size = 0;
+    std::string hash;
+  };
+
+  struct FolderContents {
+    FolderContents();
+    ~FolderContents();
+    FolderContents(FolderContents&&);
+    FolderContents& operator=(FolderContents&&);
+
+    bool exists = false;
+    std::vector<FileEntry> files;
+    // Relative paths of nested directories, parents before children.
+    std::vector<std::string> directories;
+    int64_t total_size = 0;
+  };
+
+  IpfsFolderImportWorker(content::BrowserContext* context,
+                         const GURL& endpoint,
+                         ImportCompletedCallback callback,
+                         ImportProgressCallback progress_callback,
+                         const base::FilePath& folder_path,
+                         const std::string& key = std::string());
+  ~IpfsFolderImportWorker() override;
+
+  IpfsFolderImportWorker(const IpfsFolderImportWorker&) = delete;
+  IpfsFolderImportWorker& operator=(const IpfsFolderImportWorker&) = delete;
+
+ private:
+  class FileUpload;
+
+  void OnFolderEnumerated(FolderContents contents);
+
+  void MaybeStartUploads();
+  void OnUploadRequestCreated(size_t index,
+                              std::unique_ptr<network::ResourceRequest> request);
+  void OnUploadProgress(size_t index, uint64_t position, uint64_t total);
+  void OnUploadCompleted(size_t index, bool success, const std::string& hash);
+  void NotifyProgress();
+
+  void AssembleFolder();
+  void RunNextFolderRequest();
+  void OnFolderRequestCompleted(ImportState error_state,
+                                std::unique_ptr<std::string> response_body);
+  void ResolveFolderHash();
+  void OnFolderHashResolved(std::unique_ptr<std::string> response_body);
+
+  bool IsLastRequestSucceeded() const;
+
+  base::FilePath folder_path_;
+  ImportProgressCallback progress_callback_;
+  FolderContents contents_;
+
+  size_t next_upload_ = 0;
+  size_t completed_uploads_ = 0;
+  int64_t completed_bytes_ = 0;
+  std::unordered_map<size_t, std::unique_ptr<FileUpload>> active_uploads_;
+
+  // Pending MFS requests with the state reported if they fail.
+  base::queue<std::pair<GURL, ImportState>> folder_requests_;
+  std::string folder_mfs_path_;
+  std::unique_ptr<network::SimpleURLLoader> folder_request_loader_;
+
+  base::WeakPtrFactory<IpfsFolderImportWorker> weak_factory_;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORT_WORKER_H_
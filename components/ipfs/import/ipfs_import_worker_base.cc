@@ -199,9 +199,7 @@ void IpfsImportWorkerBase::CreateBraveDirectory() {
   DCHECK(!url_loader_);
   GURL url = net::AppendQueryParameter(
       server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
-  std::string directory = kImportDirectory;
-  directory += TimeFormatDate(base::Time::Now());
-  directory += "/";
+  std::string directory = GetImportDirectory();
   url = net::AppendQueryParameter(url, "arg", directory);
 
   url_loader_ = CreateURLLoader(url, "POST");
@@ -263,6 +261,22 @@ void IpfsImportWorkerBase::OnImportFilesMoved(
                                 : IPFS_IMPORT_ERROR_MOVE_FAILED);
 }
 
+// static
+std::string IpfsImportWorkerBase::GetImportDirectory() {
+  std::string directory = kImportDirectory;
+  directory += TimeFormatDate(base::Time::Now());
+  directory += "/";
+  return directory;
+}
+
+void IpfsImportWorkerBase::PublishContentOrComplete() {
+  if (!data_->hash.empty() && !key_to_publish_.empty()) {
+    PublishContent();
+    return;
+  }
+  NotifyImportCompleted(IPFS_IMPORT_SUCCESS);
+}
+
 void IpfsImportWorkerBase::PublishContent() {
   DCHECK(!url_loader_);
   std::string from = "/ipfs/" + data_->hash;
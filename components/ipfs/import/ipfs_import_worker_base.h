@@ -68,6 +68,16 @@ class IpfsImportWorkerBase {
 
  protected:
   scoped_refptr<network::SharedURLLoaderFactory> GetUrlLoaderFactory();
+  content::BrowserContext* GetBrowserContext() { return browser_context_; }
+  const GURL& GetServerEndpoint() const { return server_endpoint_; }
+  ipfs::ImportedData* GetImportedData() { return data_.get(); }
+
+  // Returns the MFS directory where objects imported today are placed.
+  static std::string GetImportDirectory();
+
+  // Publishes imported content if a key was passed, otherwise completes
+  // the import successfully.
+  void PublishContentOrComplete();
 
   virtual void NotifyImportCompleted(ipfs::ImportState state);
 
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/process/launch.h"
@@ -18,6 +19,8 @@
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
+#include "brave/components/ipfs/features.h"
+#include "brave/components/ipfs/import/ipfs_folder_import_worker.h"
 #include "brave/components/ipfs/import/ipfs_import_worker_base.h"
 #include "brave/components/ipfs/import/ipfs_link_import_worker.h"
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -348,6 +351,15 @@ void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
   auto import_completed_callback =
       base::BindOnce(&IpfsService::OnImportFinished, weak_factory_.GetWeakPtr(),
                      std::move(callback), hash);
+  if (base::FeatureList::IsEnabled(features::kIpfsParallelFolderImport)) {
+    auto import_progress_callback =
+        base::BindRepeating(&IpfsService::OnImportProgress,
+                            weak_factory_.GetWeakPtr(), folder);
+    importers_[hash] = std::make_unique<IpfsFolderImportWorker>(
+        context_, server_endpoint_, std::move(import_completed_callback),
+        std::move(import_progress_callback), folder, key);
+    return;
+  }
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       context_, server_endpoint_, std::move(import_completed_callback), key);
   importers_[hash]->ImportFolder(folder);
@@ -380,6 +392,14 @@ void IpfsService::ImportTextToIpfs(const std::string& text,
   importers_[hash]->ImportText(text, host);
 }
 
+void IpfsService::OnImportProgress(const base::FilePath& path,
+                                   int64_t uploaded_bytes,
+                                   int64_t total_bytes) {
+  for (auto& observer : observers_) {
+    observer.OnImportProgress(path, uploaded_bytes, total_bytes);
+  }
+}
+
 void IpfsService::OnImportFinished(ipfs::ImportCompletedCallback callback,
                                    size_t key,
                                    const ipfs::ImportedData& data) {
@@ -114,6 +114,9 @@ class IpfsService : public KeyedService,
   void OnImportFinished(ipfs::ImportCompletedCallback callback,
                         size_t key,
                         const ipfs::ImportedData& data);
+  void OnImportProgress(const base::FilePath& path,
+                        int64_t uploaded_bytes,
+                        int64_t total_bytes);
   void GetConnectedPeers(GetConnectedPeersCallback callback,
                          int retries = kPeersDefaultRetries);
   void GetAddressesConfig(GetAddressesConfigCallback callback);
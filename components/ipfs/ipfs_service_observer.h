@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/observer_list_types.h"
 #include "components/component_updater/component_updater_service.h"
 
@@ -25,6 +26,11 @@ class IpfsServiceObserver : public base::CheckedObserver {
   virtual void OnGetConnectedPeers(bool succes,
                                    const std::vector<std::string>& peers) {}
   virtual void OnIpnsKeysLoaded(bool success) {}
+  // Called while a folder import started with the parallel import mode is
+  // uploading files to the node.
+  virtual void OnImportProgress(const base::FilePath& path,
+                                int64_t uploaded_bytes,
+                                int64_t total_bytes) {}
 };
 
 }  // namespace ipfs
@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/image_data_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::Optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+ImageDataCache::ImageDataCache() : unpinned_images_(kMaxUnpinnedImages) {}
+
+ImageDataCache::~ImageDataCache() = default;
+
+void ImageDataCache::GetImage(const base::FilePath& image_file_path,
+                              GetImageCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto pinned = pinned_images_.find(image_file_path);
+  if (pinned != pinned_images_.end()) {
+    std::move(callback).Run(pinned->second);
+    return;
+  }
+
+  auto unpinned = unpinned_images_.Get(image_file_path);
+  if (unpinned != unpinned_images_.end()) {
+    std::move(callback).Run(unpinned->second);
+    return;
+  }
+
+  auto pending = pending_reads_.find(image_file_path);
+  if (pending != pending_reads_.end()) {
+    pending->second.push_back(std::move(callback));
+    return;
+  }
+
+  pending_reads_[image_file_path].push_back(std::move(callback));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ImageDataCache::OnImageRead, weak_factory_.GetWeakPtr(),
+                     image_file_path));
+}
+
+void ImageDataCache::Prefetch(const base::FilePath& image_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (image_file_path.empty() || IsCached(image_file_path) ||
+      pending_reads_.count(image_file_path))
+    return;
+
+  pending_reads_[image_file_path];
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ImageDataCache::OnImageRead, weak_factory_.GetWeakPtr(),
+                     image_file_path));
+}
+
+void ImageDataCache::SetPinnedDirectory(const std::string& key,
+                                        const base::FilePath& dir) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const base::FilePath old_dir = pinned_dirs_[key];
+  if (old_dir == dir)
+    return;
+
+  if (dir.empty())
+    pinned_dirs_.erase(key);
+  else
+    pinned_dirs_[key] = dir;
+
+  if (old_dir.empty())
+    return;
+
+  // Drop images of the previous component version. They won't be requested
+  // again once observers see the new data.
+  for (auto it = pinned_images_.begin(); it != pinned_images_.end();) {
+    if (old_dir.IsParent(it->first) && !IsPinned(it->first))
+      it = pinned_images_.erase(it);
+    else
+      ++it;
+  }
+}
+
+bool ImageDataCache::IsCached(const base::FilePath& image_file_path) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return pinned_images_.count(image_file_path) ||
+         unpinned_images_.Peek(image_file_path) != unpinned_images_.end();
+}
+
+bool ImageDataCache::IsPinned(const base::FilePath& image_file_path) const {
+  for (const auto& pinned_dir : pinned_dirs_) {
+    if (pinned_dir.second.IsParent(image_file_path))
+      return true;
+  }
+  return false;
+}
+
+void ImageDataCache::OnImageRead(const base::FilePath& image_file_path,
+                                 base::Optional<std::string> contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::vector<GetImageCallback> callbacks =
+      std::move(pending_reads_[image_file_path]);
+  pending_reads_.erase(image_file_path);
+
+  scoped_refptr<base::RefCountedMemory> image;
+  if (contents) {
+    // Takes over the string buffer, so the file contents are never copied.
+    image = base::RefCountedString::TakeString(&contents.value());
+    if (IsPinned(image_file_path))
+      pinned_images_[image_file_path] = image;
+    else
+      unpinned_images_.Put(image_file_path, image);
+  }
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(image);
+}
+
+}  // namespace ntp_background_images
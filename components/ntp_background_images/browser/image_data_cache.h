@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_DATA_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_DATA_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+
+namespace ntp_background_images {
+
+// Keeps encoded image files in memory so that new tab pages don't read them
+// from disk again. Files are read once on a blocking thread and the buffer is
+// handed out as is, without copying.
+// Images under a pinned directory (the installed directory of the current
+// component version) are kept until that directory is unpinned. Other images
+// are kept in a small MRU list.
+class ImageDataCache {
+ public:
+  using GetImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  static constexpr size_t kMaxUnpinnedImages = 8;
+
+  ImageDataCache();
+  ~ImageDataCache();
+
+  ImageDataCache(const ImageDataCache&) = delete;
+  ImageDataCache& operator=(const ImageDataCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file_path|, or with null if
+  // it can't be read. Runs synchronously when the image is cached.
+  void GetImage(const base::FilePath& image_file_path,
+                GetImageCallback callback);
+  // Loads |image_file_path| into the cache if it isn't there yet.
+  void Prefetch(const base::FilePath& image_file_path);
+
+  // Pins images under |dir| for |key|. Images cached for the previously pinned
+  // directory of |key| are dropped.
+  void SetPinnedDirectory(const std::string& key, const base::FilePath& dir);
+
+  bool IsCached(const base::FilePath& image_file_path) const;
+
+ private:
+  bool IsPinned(const base::FilePath& image_file_path) const;
+  void OnImageRead(const base::FilePath& image_file_path,
+                   base::Optional<std::string> contents);
+
+  std::map<std::string, base::FilePath> pinned_dirs_;
+  std::map<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      pinned_images_;
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      unpinned_images_;
+  // Callbacks waiting for a read in flight. Prefetches have no callback.
+  std::map<base::FilePath, std::vector<GetImageCallback>> pending_reads_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<ImageDataCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_DATA_CACHE_H_
@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/image_data_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class ImageDataCacheTest : public testing::Test {
+ public:
+  ImageDataCacheTest() {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    component_dir_ = temp_dir_.GetPath().AppendASCII("1.0.0");
+    ASSERT_TRUE(base::CreateDirectory(component_dir_));
+  }
+
+  base::FilePath WriteImage(const base::FilePath& dir,
+                            const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = dir.AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  std::string GetImage(const base::FilePath& path) {
+    std::string result = "<null>";
+    cache_.GetImage(path, base::BindOnce(
+                              [](std::string* result,
+                                 scoped_refptr<base::RefCountedMemory> data) {
+                                if (data) {
+                                  *result = std::string(
+                                      data->front_as<char>(), data->size());
+                                }
+                              },
+                              &result));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath component_dir_;
+  ImageDataCache cache_;
+};
+
+TEST_F(ImageDataCacheTest, ServesCachedImageWithoutReadingAgain) {
+  const base::FilePath path =
+      WriteImage(component_dir_, "background-1.jpg", "image1");
+  cache_.SetPinnedDirectory("si", component_dir_);
+
+  EXPECT_EQ("image1", GetImage(path));
+  EXPECT_TRUE(cache_.IsCached(path));
+
+  // Cached contents are served even if the file changes on disk.
+  WriteImage(component_dir_, "background-1.jpg", "changed");
+  EXPECT_EQ("image1", GetImage(path));
+}
+
+TEST_F(ImageDataCacheTest, MissingFile) {
+  const base::FilePath path = component_dir_.AppendASCII("missing.jpg");
+  EXPECT_EQ("<null>", GetImage(path));
+  EXPECT_FALSE(cache_.IsCached(path));
+}
+
+TEST_F(ImageDataCacheTest, Prefetch) {
+  const base::FilePath path =
+      WriteImage(component_dir_, "background-2.jpg", "image2");
+  cache_.Prefetch(path);
+  EXPECT_FALSE(cache_.IsCached(path));
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache_.IsCached(path));
+}
+
+TEST_F(ImageDataCacheTest, DropsImagesOfPreviousComponentVersion) {
+  const base::FilePath old_path =
+      WriteImage(component_dir_, "background-1.jpg", "old");
+  cache_.SetPinnedDirectory("si", component_dir_);
+  EXPECT_EQ("old", GetImage(old_path));
+
+  const base::FilePath new_dir = temp_dir_.GetPath().AppendASCII("1.0.1");
+  ASSERT_TRUE(base::CreateDirectory(new_dir));
+  const base::FilePath new_path =
+      WriteImage(new_dir, "background-1.jpg", "new");
+  cache_.SetPinnedDirectory("si", new_dir);
+
+  EXPECT_FALSE(cache_.IsCached(old_path));
+  EXPECT_EQ("new", GetImage(new_path));
+}
+
+TEST_F(ImageDataCacheTest, UnpinnedImagesAreBounded) {
+  for (size_t i = 0; i <= ImageDataCache::kMaxUnpinnedImages; ++i) {
+    GetImage(WriteImage(temp_dir_.GetPath(),
+                        "favicon-" + std::to_string(i) + ".png", "icon"));
+  }
+  const base::FilePath dir = temp_dir_.GetPath();
+  EXPECT_FALSE(cache_.IsCached(dir.AppendASCII("favicon-0.png")));
+  EXPECT_TRUE(cache_.IsCached(dir.AppendASCII("favicon-1.png")));
+}
+
+}  // namespace ntp_background_images
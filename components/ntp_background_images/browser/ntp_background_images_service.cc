@@ -49,6 +49,8 @@ constexpr char kNTPSRMappingTableComponentID[] =
     "heplpbhjcbmiibdlchlanmdenffpiibo";
 constexpr char kNTPSRMappingTableComponentName[] =
     "NTP Super Referral mapping table";
+constexpr char kSIImagesCacheKey[] = "si";
+constexpr char kSRImagesCacheKey[] = "sr";
 
 std::string GetMappingTableData(const base::FilePath& installed_dir) {
   std::string contents;
@@ -463,8 +465,14 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
                                                       si_installed_dir_));
   }
 
+  // Keep images of the new component version cached and drop the old ones.
+  image_data_cache_.SetPinnedDirectory(
+      is_super_referral ? kSRImagesCacheKey : kSIImagesCacheKey,
+      is_super_referral ? sr_installed_dir_ : si_installed_dir_);
+
   if (is_super_referral && !sr_images_data_->IsValid()) {
     DVLOG(2) << __func__ << ": NTP SR campaign ends.";
+    image_data_cache_.SetPinnedDirectory(kSRImagesCacheKey, base::FilePath());
     UnRegisterSuperReferralComponent();
     MarkThisInstallIsNotSuperReferralForever();
     return;
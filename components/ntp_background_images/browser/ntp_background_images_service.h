@@ -16,6 +16,7 @@
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
 #include "base/values.h"
+#include "brave/components/ntp_background_images/browser/image_data_cache.h"
 #include "components/prefs/pref_change_registrar.h"
 
 namespace component_updater {
@@ -68,6 +69,10 @@ class NTPBackgroundImagesService {
 
   std::vector<std::string> GetTopSitesFaviconList() const;
 
+  // Shared by all profiles' new tab pages. Images of the current components
+  // stay cached until the components are updated.
+  ImageDataCache* image_data_cache() { return &image_data_cache_; }
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -154,6 +159,7 @@ class NTPBackgroundImagesService {
   // not show SI images until user chooses Brave default images. So, we should
   // know the exact timing whether SR assets is ready to use or not.
   base::Value initial_sr_component_info_;
+  ImageDataCache image_data_cache_;
   base::WeakPtrFactory<NTPBackgroundImagesService> weak_factory_;
 };
 
@@ -19,6 +19,7 @@
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/ntp_background_images/browser/features.h"
+#include "brave/components/ntp_background_images/browser/image_data_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
@@ -217,6 +218,25 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    PrefetchWallpaperImages();
+  }
+}
+
+void ViewCounterService::PrefetchWallpaperImages() {
+  auto* data = GetCurrentBrandedWallpaperData();
+  if (!data || data->backgrounds.empty())
+    return;
+
+  // The current index is shown when the branded wallpaper is due, and the
+  // following one is the next in the rotation.
+  const int count = data->backgrounds.size();
+  const int index = model_.current_wallpaper_image_index();
+  auto* cache = service_->image_data_cache();
+  for (int i : {index % count, (index + 1) % count}) {
+    const auto& background = data->backgrounds[i];
+    cache->Prefetch(background.image_file);
+    cache->Prefetch(background.logo ? background.logo->image_file
+                                    : data->default_logo.image_file);
   }
 }
 
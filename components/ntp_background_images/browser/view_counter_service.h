@@ -120,6 +120,10 @@ class ViewCounterService : public KeyedService,
 
   void ResetModel();
 
+  // Loads the wallpaper shown next into NTPBackgroundImagesService's image
+  // cache so the new tab page doesn't wait for the disk.
+  void PrefetchWallpaperImages();
+
   void UpdateP3AValues() const;
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
@@ -7,9 +7,11 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
-#include "base/logging.h"
 
 namespace bat_ads {
 
@@ -36,6 +38,7 @@ bool BatAdsClientMojoBridge::CanShowBackgroundNotifications() const {
     return false;
 
   bool can_show;
+  CountSyncCall();
   bat_ads_client_->CanShowBackgroundNotifications(&can_show);
   return can_show;
 }
@@ -46,6 +49,7 @@ bool BatAdsClientMojoBridge::IsNetworkConnectionAvailable() const {
   }
 
   bool is_available;
+  CountSyncCall();
   bat_ads_client_->IsNetworkConnectionAvailable(&is_available);
   return is_available;
 }
@@ -56,6 +60,7 @@ bool BatAdsClientMojoBridge::IsForeground() const {
   }
 
   bool is_foreground;
+  CountSyncCall();
   bat_ads_client_->IsForeground(&is_foreground);
   return is_foreground;
 }
@@ -66,6 +71,7 @@ bool BatAdsClientMojoBridge::IsFullScreen() const {
   }
 
   bool is_full_screen;
+  CountSyncCall();
   bat_ads_client_->IsFullScreen(&is_full_screen);
   return is_full_screen;
 }
@@ -76,6 +82,10 @@ void BatAdsClientMojoBridge::ShowNotification(
     return;
   }
 
+  VLOG(1) << sync_calls_since_last_notification_
+          << " sync calls to the browser since the last ad notification";
+  sync_calls_since_last_notification_ = 0;
+
   bat_ads_client_->ShowNotification(info.ToJson());
 }
 
@@ -85,6 +95,7 @@ bool BatAdsClientMojoBridge::ShouldShowNotifications() {
   }
 
   bool should_show;
+  CountSyncCall();
   bat_ads_client_->ShouldShowNotifications(&should_show);
   return should_show;
 }
@@ -116,6 +127,7 @@ std::vector<uint64_t> BatAdsClientMojoBridge::GetAdEvents(
   }
 
   std::vector<uint64_t> ad_events;
+  CountSyncCall();
   bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_events);
   return ad_events;
 }
@@ -246,6 +258,7 @@ std::string BatAdsClientMojoBridge::LoadResourceForId(
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->LoadResourceForId(id, &value);
   return value;
 }
@@ -285,12 +298,18 @@ void BatAdsClientMojoBridge::Log(
 
 bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && mirrored_value->is_bool()) {
+    return mirrored_value->GetBool();
+  }
+
   bool value = false;
 
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetBooleanPref(path, &value);
   return value;
 }
@@ -302,17 +321,24 @@ void BatAdsClientMojoBridge::SetBooleanPref(
     return;
   }
 
-  bat_ads_client_->SetBooleanPref(path, value);
+  UpdateMirroredPref(path, base::Value(value));
+  bat_ads_client_->SetBooleanPref(path, value, OnSetPrefCallback(path));
 }
 
 int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && mirrored_value->is_int()) {
+    return mirrored_value->GetInt();
+  }
+
   int value = 0;
 
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetIntegerPref(path, &value);
   return value;
 }
@@ -324,17 +350,25 @@ void BatAdsClientMojoBridge::SetIntegerPref(
     return;
   }
 
-  bat_ads_client_->SetIntegerPref(path, value);
+  UpdateMirroredPref(path, base::Value(value));
+  bat_ads_client_->SetIntegerPref(path, value, OnSetPrefCallback(path));
 }
 
 double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && (mirrored_value->is_double() ||
+                         mirrored_value->is_int())) {
+    return mirrored_value->GetDouble();
+  }
+
   double value = 0.0;
 
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetDoublePref(path, &value);
   return value;
 }
@@ -346,17 +380,24 @@ void BatAdsClientMojoBridge::SetDoublePref(
     return;
   }
 
-  bat_ads_client_->SetDoublePref(path, value);
+  UpdateMirroredPref(path, base::Value(value));
+  bat_ads_client_->SetDoublePref(path, value, OnSetPrefCallback(path));
 }
 
 std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && mirrored_value->is_string()) {
+    return mirrored_value->GetString();
+  }
+
   std::string value;
 
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetStringPref(path, &value);
   return value;
 }
@@ -368,17 +409,28 @@ void BatAdsClientMojoBridge::SetStringPref(
     return;
   }
 
-  bat_ads_client_->SetStringPref(path, value);
+  UpdateMirroredPref(path, base::Value(value));
+  bat_ads_client_->SetStringPref(path, value, OnSetPrefCallback(path));
 }
 
 int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
+  // 64-bit integer prefs are stored as strings.
   int64_t value = 0;
 
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && mirrored_value->is_string() &&
+      base::StringToInt64(mirrored_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetInt64Pref(path, &value);
   return value;
 }
@@ -390,17 +442,28 @@ void BatAdsClientMojoBridge::SetInt64Pref(
     return;
   }
 
-  bat_ads_client_->SetInt64Pref(path, value);
+  UpdateMirroredPref(path, base::Value(base::NumberToString(value)));
+  bat_ads_client_->SetInt64Pref(path, value, OnSetPrefCallback(path));
 }
 
 uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
+  // 64-bit integer prefs are stored as strings.
   uint64_t value = 0;
 
+  const base::Value* mirrored_value = GetMirroredPref(path);
+  if (mirrored_value && mirrored_value->is_string() &&
+      base::StringToUint64(mirrored_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+
   if (!connected()) {
     return value;
   }
 
+  CountSyncCall();
   bat_ads_client_->GetUint64Pref(path, &value);
   return value;
 }
@@ -412,7 +475,8 @@ void BatAdsClientMojoBridge::SetUint64Pref(
     return;
   }
 
-  bat_ads_client_->SetUint64Pref(path, value);
+  UpdateMirroredPref(path, base::Value(base::NumberToString(value)));
+  bat_ads_client_->SetUint64Pref(path, value, OnSetPrefCallback(path));
 }
 
 void BatAdsClientMojoBridge::ClearPref(
@@ -421,13 +485,70 @@ void BatAdsClientMojoBridge::ClearPref(
     return;
   }
 
+  // The default value is only known to the browser. Reads fall back to sync
+  // calls until the browser pushes the cleared value.
+  mirrored_prefs_.erase(path);
   bat_ads_client_->ClearPref(path);
 }
 
+void BatAdsClientMojoBridge::OnPrefChanged(
+    const std::string& path,
+    base::Value value) {
+  // A value pushed while our own write is in flight was read before that
+  // write was applied, so the mirror already holds the newer value.
+  if (pending_pref_writes_.count(path)) {
+    return;
+  }
+
+  mirrored_prefs_[path] = std::move(value);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+void BatAdsClientMojoBridge::CountSyncCall() const {
+  sync_calls_since_last_notification_++;
+}
+
+const base::Value* BatAdsClientMojoBridge::GetMirroredPref(
+    const std::string& path) const {
+  const auto iter = mirrored_prefs_.find(path);
+  if (iter == mirrored_prefs_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatAdsClientMojoBridge::UpdateMirroredPref(
+    const std::string& path,
+    base::Value value) {
+  pending_pref_writes_[path]++;
+
+  // Only prefs pushed by the browser are mirrored, other prefs are not
+  // observed so a local copy could go stale.
+  const auto iter = mirrored_prefs_.find(path);
+  if (iter != mirrored_prefs_.end()) {
+    iter->second = std::move(value);
+  }
+}
+
+base::OnceClosure BatAdsClientMojoBridge::OnSetPrefCallback(
+    const std::string& path) {
+  return base::BindOnce(&BatAdsClientMojoBridge::OnSetPref,
+                        weak_factory_.GetWeakPtr(), path);
+}
+
+void BatAdsClientMojoBridge::OnSetPref(
+    const std::string& path) {
+  const auto iter = pending_pref_writes_.find(path);
+  DCHECK(iter != pending_pref_writes_.end());
+  if (--iter->second == 0) {
+    pending_pref_writes_.erase(iter);
+  }
+}
+
 }  // namespace bat_ads
@@ -10,6 +10,10 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -133,10 +137,38 @@ class BatAdsClientMojoBridge
   void ClearPref(
       const std::string& path) override;
 
+  // Updates the local mirror with a pref value pushed by the browser.
+  void OnPrefChanged(
+      const std::string& path,
+      base::Value value);
+
  private:
   bool connected() const;
 
+  void CountSyncCall() const;
+
+  const base::Value* GetMirroredPref(
+      const std::string& path) const;
+  void UpdateMirroredPref(
+      const std::string& path,
+      base::Value value);
+  base::OnceClosure OnSetPrefCallback(
+      const std::string& path);
+  void OnSetPref(
+      const std::string& path);
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  // Ads prefs pushed by the browser, as stored in its PrefService, so reads
+  // don't block on a sync call. Prefs that are not mirrored are read through
+  // sync calls.
+  base::flat_map<std::string, base::Value> mirrored_prefs_;
+  // Writes not yet acknowledged by the browser, by pref path.
+  base::flat_map<std::string, int> pending_pref_writes_;
+
+  mutable int sync_calls_since_last_notification_ = 0;
+
+  base::WeakPtrFactory<BatAdsClientMojoBridge> weak_factory_{this};
 };
 
 }  // namespace bat_ads
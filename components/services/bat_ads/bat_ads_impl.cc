@@ -256,6 +256,10 @@ void BatAdsImpl::OnResourceComponentUpdated(const std::string& id) {
   ads_->OnResourceComponentUpdated(id);
 }
 
+void BatAdsImpl::OnPrefChanged(const std::string& path, base::Value value) {
+  bat_ads_client_mojo_proxy_->OnPrefChanged(path, std::move(value));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void BatAdsImpl::OnInitialize(
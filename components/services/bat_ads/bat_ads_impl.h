@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "bat/ads/ads.h"
@@ -142,6 +143,8 @@ class BatAdsImpl :
 
   void OnResourceComponentUpdated(const std::string& id) override;
 
+  void OnPrefChanged(const std::string& path, base::Value value) override;
+
  private:
   // Workaround to pass base::OnceCallback into std::bind
   template <typename Callback>
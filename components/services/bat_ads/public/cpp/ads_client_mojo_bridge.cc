@@ -305,8 +305,10 @@ void AdsClientMojoBridge::GetBooleanPref(
 
 void AdsClientMojoBridge::SetBooleanPref(
     const std::string& path,
-    const bool value) {
+    const bool value,
+    SetBooleanPrefCallback callback) {
   ads_client_->SetBooleanPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetIntegerPref(
@@ -317,8 +319,10 @@ void AdsClientMojoBridge::GetIntegerPref(
 
 void AdsClientMojoBridge::SetIntegerPref(
     const std::string& path,
-    const int value) {
+    const int value,
+    SetIntegerPrefCallback callback) {
   ads_client_->SetIntegerPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetDoublePref(
@@ -329,8 +333,10 @@ void AdsClientMojoBridge::GetDoublePref(
 
 void AdsClientMojoBridge::SetDoublePref(
     const std::string& path,
-    const double value) {
+    const double value,
+    SetDoublePrefCallback callback) {
   ads_client_->SetDoublePref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetStringPref(
@@ -341,8 +347,10 @@ void AdsClientMojoBridge::GetStringPref(
 
 void AdsClientMojoBridge::SetStringPref(
     const std::string& path,
-    const std::string& value) {
+    const std::string& value,
+    SetStringPrefCallback callback) {
   ads_client_->SetStringPref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetInt64Pref(
@@ -353,8 +361,10 @@ void AdsClientMojoBridge::GetInt64Pref(
 
 void AdsClientMojoBridge::SetInt64Pref(
     const std::string& path,
-    const int64_t value) {
+    const int64_t value,
+    SetInt64PrefCallback callback) {
   ads_client_->SetInt64Pref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::GetUint64Pref(
@@ -365,8 +375,10 @@ void AdsClientMojoBridge::GetUint64Pref(
 
 void AdsClientMojoBridge::SetUint64Pref(
     const std::string& path,
-    const uint64_t value) {
+    const uint64_t value,
+    SetUint64PrefCallback callback) {
   ads_client_->SetUint64Pref(path, value);
+  std::move(callback).Run();
 }
 
 void AdsClientMojoBridge::ClearPref(
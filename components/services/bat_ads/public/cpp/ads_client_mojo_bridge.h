@@ -104,37 +104,43 @@ class AdsClientMojoBridge
       GetBooleanPrefCallback callback) override;
   void SetBooleanPref(
       const std::string& path,
-      const bool value) override;
+      const bool value,
+      SetBooleanPrefCallback callback) override;
   void GetIntegerPref(
       const std::string& path,
       GetIntegerPrefCallback callback) override;
   void SetIntegerPref(
       const std::string& path,
-      const int value) override;
+      const int value,
+      SetIntegerPrefCallback callback) override;
   void GetDoublePref(
       const std::string& path,
       GetDoublePrefCallback callback) override;
   void SetDoublePref(
       const std::string& path,
-      const double value) override;
+      const double value,
+      SetDoublePrefCallback callback) override;
   void GetStringPref(
       const std::string& path,
       GetStringPrefCallback callback) override;
   void SetStringPref(
       const std::string& path,
-      const std::string& value) override;
+      const std::string& value,
+      SetStringPrefCallback callback) override;
   void GetInt64Pref(
       const std::string& path,
       GetInt64PrefCallback callback) override;
   void SetInt64Pref(
       const std::string& path,
-      const int64_t value) override;
+      const int64_t value,
+      SetInt64PrefCallback callback) override;
   void GetUint64Pref(
       const std::string& path,
       GetUint64PrefCallback callback) override;
   void SetUint64Pref(
       const std::string& path,
-      const uint64_t value) override;
+      const uint64_t value,
+      SetUint64PrefCallback callback) override;
   void ClearPref(
       const std::string& path) override;
 
@@ -11,15 +11,50 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+#include "bat/ledger/ledger_database.h"
+#include "net/base/escape.h"
 
 namespace bat_ledger {
 
+namespace {
+
+ledger::type::DBCommandResponsePtr RunDBTransactionOnDatabaseTaskRunner(
+    ledger::type::DBTransactionPtr transaction,
+    ledger::LedgerDatabase* database) {
+  auto response = ledger::type::DBCommandResponse::New();
+  database->RunTransaction(std::move(transaction), response.get());
+  return response;
+}
+
+void CloseDatabaseOnDatabaseTaskRunner(
+    std::unique_ptr<ledger::LedgerDatabase> database) {
+  database.reset();
+}
+
+}  // namespace
+
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path) {
   bat_ledger_client_.Bind(std::move(client_info));
+
+  if (!database_path.empty()) {
+    database_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+    ledger_database_.reset(
+        ledger::LedgerDatabase::CreateInstance(database_path));
+  }
 }
 
-BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
+BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() {
+  if (ledger_database_) {
+    database_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
+  }
+}
 
 void OnLoadURL(
     const ledger::client::LoadURLCallback& callback,
@@ -131,12 +166,8 @@ void BatLedgerClientMojoBridge::FetchFavIcon(const std::string& url,
 }
 
 std::string BatLedgerClientMojoBridge::URIEncode(const std::string& value) {
-  if (!Connected())
-    return "";
-
-  std::string encoded_value;
-  bat_ledger_client_->URIEncode(value, &encoded_value);
-  return encoded_value;
+  // Same encoding as RewardsServiceImpl::URIEncode, without the sync call.
+  return net::EscapeQueryParamValue(value, false);
 }
 
 void BatLedgerClientMojoBridge::PublisherListNormalized(
@@ -230,36 +261,61 @@ bool BatLedgerClientMojoBridge::GetBooleanOption(
 }
 
 int BatLedgerClientMojoBridge::GetIntegerOption(const std::string& name) const {
+  const auto iter = integer_options_.find(name);
+  if (iter != integer_options_.end())
+    return iter->second;
+
   int value;
-  bat_ledger_client_->GetIntegerOption(name, &value);
+  if (bat_ledger_client_->GetIntegerOption(name, &value))
+    integer_options_[name] = value;
   return value;
 }
 
 double BatLedgerClientMojoBridge::GetDoubleOption(
     const std::string& name) const {
+  const auto iter = double_options_.find(name);
+  if (iter != double_options_.end())
+    return iter->second;
+
   double value;
-  bat_ledger_client_->GetDoubleOption(name, &value);
+  if (bat_ledger_client_->GetDoubleOption(name, &value))
+    double_options_[name] = value;
   return value;
 }
 
 std::string BatLedgerClientMojoBridge::GetStringOption(
     const std::string& name) const {
+  const auto iter = string_options_.find(name);
+  if (iter != string_options_.end())
+    return iter->second;
+
   std::string value;
-  bat_ledger_client_->GetStringOption(name, &value);
+  if (bat_ledger_client_->GetStringOption(name, &value))
+    string_options_[name] = value;
   return value;
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64Option(
     const std::string& name) const {
+  const auto iter = int64_options_.find(name);
+  if (iter != int64_options_.end())
+    return iter->second;
+
   int64_t value;
-  bat_ledger_client_->GetInt64Option(name, &value);
+  if (bat_ledger_client_->GetInt64Option(name, &value))
+    int64_options_[name] = value;
   return value;
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64Option(
     const std::string& name) const {
+  const auto iter = uint64_options_.find(name);
+  if (iter != uint64_options_.end())
+    return iter->second;
+
   uint64_t value;
-  bat_ledger_client_->GetUint64Option(name, &value);
+  if (bat_ledger_client_->GetUint64Option(name, &value))
+    uint64_options_[name] = value;
   return value;
 }
 
@@ -326,11 +382,37 @@ void OnRunDBTransaction(
 void BatLedgerClientMojoBridge::RunDBTransaction(
     ledger::type::DBTransactionPtr transaction,
     ledger::client::RunDBTransactionCallback callback) {
+  if (database_task_runner_ && !ledger_database_) {
+    // The database owned by this process was closed.
+    auto response = ledger::type::DBCommandResponse::New();
+    response->status = ledger::type::DBCommandResponse::Status::RESPONSE_ERROR;
+    callback(std::move(response));
+    return;
+  }
+
+  if (ledger_database_) {
+    // |ledger_database_| is deleted on |database_task_runner_| after all
+    // transactions posted before, so it outlives this task.
+    base::PostTaskAndReplyWithResult(
+        database_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&RunDBTransactionOnDatabaseTaskRunner,
+                       std::move(transaction), ledger_database_.get()),
+        base::BindOnce(&BatLedgerClientMojoBridge::OnRunLocalDBTransaction,
+                       AsWeakPtr(), std::move(callback)));
+    return;
+  }
+
   bat_ledger_client_->RunDBTransaction(
       std::move(transaction),
       base::BindOnce(&OnRunDBTransaction, std::move(callback)));
 }
 
+void BatLedgerClientMojoBridge::OnRunLocalDBTransaction(
+    ledger::client::RunDBTransactionCallback callback,
+    ledger::type::DBCommandResponsePtr response) {
+  callback(std::move(response));
+}
+
 void OnGetCreateScript(
     const ledger::client::GetCreateScriptCallback& callback,
     const std::string& script,
@@ -385,4 +467,19 @@ std::string BatLedgerClientMojoBridge::GetEncryptedStringState(
   return value;
 }
 
+void BatLedgerClientMojoBridge::CloseDatabase(base::OnceClosure callback) {
+  if (!ledger_database_) {
+    std::move(callback).Run();
+    return;
+  }
+
+  // Queued after every transaction posted before, like the deletion in the
+  // destructor.
+  database_task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(&CloseDatabaseOnDatabaseTaskRunner,
+                     std::move(ledger_database_)),
+      std::move(callback));
+}
+
 }  // namespace bat_ledger
@@ -11,20 +11,34 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
 
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace ledger {
+class LedgerDatabase;
+}  // namespace ledger
+
 namespace bat_ledger {
 
 class BatLedgerClientMojoBridge :
     public ledger::LedgerClient,
     public base::SupportsWeakPtr<BatLedgerClientMojoBridge>{
  public:
+  // Transactions run against a database opened in this process if
+  // |database_path| is not empty, and are sent to the browser otherwise.
   BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerClientMojoBridge() override;
 
   BatLedgerClientMojoBridge(const BatLedgerClientMojoBridge&) = delete;
@@ -124,10 +138,31 @@ class BatLedgerClientMojoBridge :
 
   std::string GetEncryptedStringState(const std::string& name) override;
 
+  // Closes the database owned by this process. Transactions run afterwards
+  // fail. |callback| runs once the file is closed.
+  void CloseDatabase(base::OnceClosure callback);
+
  private:
   bool Connected() const;
 
+  void OnRunLocalDBTransaction(
+      ledger::client::RunDBTransactionCallback callback,
+      ledger::type::DBCommandResponsePtr response);
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  // Only set when the database is owned by this process. |ledger_database_|
+  // lives on |database_task_runner_|.
+  scoped_refptr<base::SequencedTaskRunner> database_task_runner_;
+  std::unique_ptr<ledger::LedgerDatabase> ledger_database_;
+
+  // Non-boolean options are constants in the browser, so each one is fetched
+  // once. Boolean options depend on the wallet and are always fetched.
+  mutable std::map<std::string, int> integer_options_;
+  mutable std::map<std::string, double> double_options_;
+  mutable std::map<std::string, std::string> string_options_;
+  mutable std::map<std::string, int64_t> int64_options_;
+  mutable std::map<std::string, uint64_t> uint64_options_;
 };
 
 }  // namespace bat_ledger
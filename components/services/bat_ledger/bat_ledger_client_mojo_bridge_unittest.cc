@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "bat/ledger/ledger_database.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoBridgeTest.*
+
+namespace bat_ledger {
+
+namespace {
+
+const char kCreateTableQuery[] = "CREATE TABLE test (value INTEGER)";
+const char kInsertQuery[] = "INSERT INTO test (value) VALUES (1)";
+
+ledger::type::DBTransactionPtr CreateTransaction(const std::string& query) {
+  auto command = ledger::type::DBCommand::New();
+  command->type = ledger::type::DBCommand::Type::EXECUTE;
+  command->command = query;
+
+  auto transaction = ledger::type::DBTransaction::New();
+  transaction->commands.push_back(std::move(command));
+  return transaction;
+}
+
+}  // namespace
+
+class BatLedgerClientMojoBridgeTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_path_ = temp_dir_.GetPath().AppendASCII("publisher_info_db");
+
+    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client;
+    client_receiver_ = client.InitWithNewEndpointAndPassReceiver();
+    client_receiver_.EnableUnassociatedUsage();
+    bridge_ = std::make_unique<BatLedgerClientMojoBridge>(std::move(client),
+                                                          database_path_);
+  }
+
+  ledger::type::DBCommandResponse::Status RunTransaction(
+      const std::string& query) {
+    auto status = ledger::type::DBCommandResponse::Status::RESPONSE_ERROR;
+    base::RunLoop run_loop;
+    bridge_->RunDBTransaction(
+        CreateTransaction(query),
+        [&run_loop, &status](ledger::type::DBCommandResponsePtr response) {
+          ASSERT_TRUE(response);
+          status = response->status;
+          run_loop.Quit();
+        });
+    run_loop.Run();
+    return status;
+  }
+
+  // Runs |query| against a new connection to the database file, which fails
+  // while another connection holds the lock on it
+  ledger::type::DBCommandResponse::Status RunTransactionInNewConnection(
+      const std::string& query) {
+    std::unique_ptr<ledger::LedgerDatabase> database(
+        ledger::LedgerDatabase::CreateInstance(database_path_));
+    auto response = ledger::type::DBCommandResponse::New();
+    database->RunTransaction(CreateTransaction(query), response.get());
+    return response->status;
+  }
+
+  void CloseDatabase() {
+    base::RunLoop run_loop;
+    bridge_->CloseDatabase(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath database_path_;
+  mojo::PendingAssociatedReceiver<mojom::BatLedgerClient> client_receiver_;
+  std::unique_ptr<BatLedgerClientMojoBridge> bridge_;
+};
+
+TEST_F(BatLedgerClientMojoBridgeTest, RunsTransactionsInProcess) {
+  EXPECT_EQ(RunTransaction(kCreateTableQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+  EXPECT_EQ(RunTransaction(kInsertQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+
+  EXPECT_TRUE(base::PathExists(database_path_));
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, CloseDatabaseReleasesFile) {
+  ASSERT_EQ(RunTransaction(kCreateTableQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+
+  CloseDatabase();
+
+  EXPECT_EQ(RunTransaction(kInsertQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_ERROR);
+
+  EXPECT_EQ(RunTransactionInNewConnection(kInsertQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+
+  EXPECT_TRUE(base::DeleteFile(database_path_));
+  EXPECT_FALSE(base::PathExists(database_path_));
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, ReleasesFileWhenDestroyed) {
+  ASSERT_EQ(RunTransaction(kCreateTableQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+
+  // Happens when the browser disconnects without shutting down the ledger
+  bridge_.reset();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(RunTransactionInNewConnection(kInsertQuery),
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+}
+
+}  // namespace bat_ledger
@@ -22,9 +22,10 @@ using std::placeholders::_3;
 namespace bat_ledger {
 
 BatLedgerImpl::BatLedgerImpl(
-    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info)
+    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+    const base::FilePath& database_path)
   : bat_ledger_client_mojo_bridge_(
-      new BatLedgerClientMojoBridge(std::move(client_info))),
+      new BatLedgerClientMojoBridge(std::move(client_info), database_path)),
     ledger_(
       ledger::Ledger::CreateInstance(bat_ledger_client_mojo_bridge_.get())) {
 }
@@ -1103,6 +1104,10 @@ void BatLedgerImpl::Shutdown(ShutdownCallback callback) {
           _1));
 }
 
+void BatLedgerImpl::CloseDatabase(CloseDatabaseCallback callback) {
+  bat_ledger_client_mojo_bridge_->CloseDatabase(std::move(callback));
+}
+
 // static
 void BatLedgerImpl::OnGetEventLogs(
     CallbackHolder<GetEventLogsCallback>* holder,
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
@@ -26,8 +27,11 @@ class BatLedgerImpl :
     public mojom::BatLedger,
     public base::SupportsWeakPtr<BatLedgerImpl> {
  public:
-  explicit BatLedgerImpl(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+  // If |database_path| is not empty, the database is opened and used in this
+  // process.
+  BatLedgerImpl(
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerImpl() override;
 
   BatLedgerImpl(const BatLedgerImpl&) = delete;
@@ -242,6 +246,8 @@ class BatLedgerImpl :
 
   void Shutdown(ShutdownCallback callback) override;
 
+  void CloseDatabase(CloseDatabaseCallback callback) override;
+
   void GetEventLogs(GetEventLogsCallback callback) override;
 
   void GetBraveWallet(GetBraveWalletCallback callback) override;
@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "base/files/file_path.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
@@ -39,6 +40,7 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
   void SetReconcileInterval(const int32_t interval) override;
   void SetShortRetries(bool short_retries) override;
   void SetTesting() override;
+  void SetDatabasePath(const base::FilePath& path) override;
 
   void GetEnvironment(GetEnvironmentCallback callback) override;
   void GetDebug(GetDebugCallback callback) override;
@@ -48,6 +50,7 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
  private:
   mojo::Receiver<mojom::BatLedgerService> receiver_;
   bool initialized_;
+  base::FilePath database_path_;
   mojo::UniqueAssociatedReceiverSet<mojom::BatLedger> associated_receivers_;
 };
 
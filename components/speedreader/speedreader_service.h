@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "brave/components/weekly_storage/weekly_storage.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 class PrefRegistrySimple;
@@ -25,11 +26,15 @@ class SpeedreaderService : public KeyedService {
   void ToggleSpeedreader();
   bool IsEnabled();
 
+  // KeyedService:
+  void Shutdown() override;
+
   SpeedreaderService(const SpeedreaderService&) = delete;
   SpeedreaderService& operator=(const SpeedreaderService&) = delete;
 
  private:
   PrefService* prefs_ = nullptr;
+  WeeklyStorage weekly_toggles_;
 };
 
 }  // namespace speedreader
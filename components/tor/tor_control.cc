@@ -7,6 +7,7 @@
 
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task/task_traits.h"
@@ -36,13 +37,10 @@ const net::NetworkTrafficAnnotationTag tor_control_traffic_annotation =
 
 const size_t kTorBufferSize = 4096;
 
-constexpr char kGetVersionCmd[] = "GETINFO version";
-constexpr char kGetVersionReply[] = "version=";
-constexpr char kGetSOCKSListenersCmd[] = "GETINFO net/listeners/socks";
-constexpr char kGetSOCKSListenersReply[] = "net/listeners/socks=";
-constexpr char kGetCircuitEstablishedCmd[] =
-    "GETINFO status/circuit-established";
-constexpr char kGetCircuitEstablishedReply[] = "status/circuit-established=";
+constexpr char kGetInfoCmd[] = "GETINFO";
+constexpr char kVersionKey[] = "version";
+constexpr char kSOCKSListenersKey[] = "net/listeners/socks";
+constexpr char kCircuitEstablishedKey[] = "status/circuit-established";
 
 static std::string escapify(const char* buf, int len) {
   std::ostringstream s;
@@ -370,6 +368,70 @@ void TorControl::DoCmd(std::string cmd,
   }
 }
 
+// DoGetInfo(key, callback)
+//
+//      Queue key for the next GETINFO command and call callback with
+//      its values once the reply is in.  Keys requested in the same
+//      task share one command, so the startup queries cost a single
+//      round trip.
+//
+void TorControl::DoGetInfo(const std::string& key, GetInfoCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (!getinfo_batch_) {
+    getinfo_batch_ = std::make_unique<GetInfoBatch>();
+    io_task_runner_->PostTask(FROM_HERE,
+                              base::BindOnce(&TorControl::SendGetInfo,
+                                             weak_ptr_factory_.GetWeakPtr()));
+  }
+  getinfo_batch_->values[key];
+  getinfo_batch_->callbacks.emplace_back(key, std::move(callback));
+}
+
+// SendGetInfo()
+//
+//      Issue one GETINFO command for all queued keys.
+//
+void TorControl::SendGetInfo() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  DCHECK(getinfo_batch_);
+  std::string cmd = kGetInfoCmd;
+  for (const auto& entry : getinfo_batch_->values)
+    cmd += " " + entry.first;
+  GetInfoBatch* batch = getinfo_batch_.get();
+  DoCmd(std::move(cmd),
+        base::BindRepeating(&TorControl::GetInfoLine,
+                            weak_ptr_factory_.GetWeakPtr(), batch),
+        base::BindOnce(&TorControl::GetInfoDone,
+                       weak_ptr_factory_.GetWeakPtr(),
+                       std::move(getinfo_batch_)));
+}
+
+void TorControl::GetInfoLine(GetInfoBatch* batch,
+                             const std::string& status,
+                             const std::string& reply) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  const size_t eq = reply.find('=');
+  auto found = eq == std::string::npos
+                   ? batch->values.end()
+                   : batch->values.find(reply.substr(0, eq));
+  if (status != "250" || found == batch->values.end()) {
+    VLOG(0) << "tor: unexpected " << kGetInfoCmd << " reply";
+    return;
+  }
+  found->second.push_back(reply.substr(eq + 1));
+}
+
+void TorControl::GetInfoDone(std::unique_ptr<GetInfoBatch> batch,
+                             bool error,
+                             const std::string& status,
+                             const std::string& reply) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  for (auto& entry : batch->callbacks) {
+    std::move(entry.second)
+        .Run(error, status, reply, batch->values[entry.first]);
+  }
+}
+
 // GetVersion(callback)
 //
 //      Get the Tor version and call callback(error, version).
@@ -377,151 +439,104 @@ void TorControl::DoCmd(std::string cmd,
 void TorControl::GetVersion(
     base::OnceCallback<void(bool error, const std::string& version)> callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
-  std::unique_ptr<std::string> version = std::make_unique<std::string>();
-  std::string* version_p = version.get();
   io_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          &TorControl::DoCmd, weak_ptr_factory_.GetWeakPtr(), kGetVersionCmd,
-          base::BindRepeating(&TorControl::GetVersionLine,
-                              weak_ptr_factory_.GetWeakPtr(), version_p),
-          base::BindOnce(&TorControl::GetVersionDone,
-                         weak_ptr_factory_.GetWeakPtr(), std::move(version),
-                         std::move(callback))));
-}
-
-void TorControl::GetVersionLine(std::string* version,
-                                const std::string& status,
-                                const std::string& reply) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (status != "250" ||
-      !base::StartsWith(reply, kGetVersionReply,
-                        base::CompareCase::SENSITIVE) ||
-      !version->empty()) {
-    VLOG(0) << "tor: unexpected " << kGetVersionCmd << " reply";
-    return;
-  }
-  *version = reply.substr(strlen(kGetVersionReply));
+      base::BindOnce(&TorControl::DoGetInfo, weak_ptr_factory_.GetWeakPtr(),
+                     kVersionKey,
+                     base::BindOnce(&TorControl::GetVersionDone,
+                                    weak_ptr_factory_.GetWeakPtr(),
+                                    std::move(callback))));
 }
 
 void TorControl::GetVersionDone(
-    std::unique_ptr<std::string> version,
     base::OnceCallback<void(bool error, const std::string& version)> callback,
     bool error,
     const std::string& status,
-    const std::string& reply) {
+    const std::string& reply,
+    const std::vector<std::string>& values) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (error || status != "250" || reply != "OK" || version->empty()) {
+  if (error || status != "250" || reply != "OK" || values.size() != 1 ||
+      values[0].empty()) {
     std::move(callback).Run(true, "");
     return;
   }
-  std::move(callback).Run(false, *version);
+  std::move(callback).Run(false, values[0]);
 }
 
 void TorControl::GetSOCKSListeners(
     base::OnceCallback<
         void(bool error, const std::vector<std::string>& listeners)> callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
-  std::unique_ptr<std::vector<std::string>> listeners =
-      std::make_unique<std::vector<std::string>>();
-  std::vector<std::string>* listeners_p = listeners.get();
   io_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          &TorControl::DoCmd, weak_ptr_factory_.GetWeakPtr(),
-          kGetSOCKSListenersCmd,
-          base::BindRepeating(&TorControl::GetSOCKSListenersLine,
-                              weak_ptr_factory_.GetWeakPtr(), listeners_p),
-          base::BindOnce(&TorControl::GetSOCKSListenersDone,
-                         weak_ptr_factory_.GetWeakPtr(), std::move(listeners),
-                         std::move(callback))));
-}
-
-void TorControl::GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                                       const std::string& status,
-                                       const std::string& reply) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (status != "250" || !base::StartsWith(reply, kGetSOCKSListenersReply,
-                                           base::CompareCase::SENSITIVE)) {
-    VLOG(0) << "tor: unexpected " << kGetSOCKSListenersCmd << " reply";
-    return;
-  }
-  listeners->push_back(reply.substr(strlen(kGetSOCKSListenersReply)));
+      base::BindOnce(&TorControl::DoGetInfo, weak_ptr_factory_.GetWeakPtr(),
+                     kSOCKSListenersKey,
+                     base::BindOnce(&TorControl::GetSOCKSListenersDone,
+                                    weak_ptr_factory_.GetWeakPtr(),
+                                    std::move(callback))));
 }
 
 void TorControl::GetSOCKSListenersDone(
-    std::unique_ptr<std::vector<std::string>> listeners,
     base::OnceCallback<
         void(bool error, const std::vector<std::string>& listeners)> callback,
     bool error,
     const std::string& status,
-    const std::string& reply) {
+    const std::string& reply,
+    const std::vector<std::string>& values) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (error || status != "250" || reply != "OK" || listeners->empty()) {
+  if (error || status != "250" || reply != "OK" || values.empty()) {
     std::move(callback).Run(true, std::vector<std::string>());
     return;
   }
-  std::move(callback).Run(false, *listeners);
+  std::move(callback).Run(false, values);
 }
 
 void TorControl::GetCircuitEstablished(
     base::OnceCallback<void(bool error, bool established)> callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
-  std::unique_ptr<std::string> established = std::make_unique<std::string>();
-  std::string* established_p = established.get();
   io_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          &TorControl::DoCmd, weak_ptr_factory_.GetWeakPtr(),
-          kGetCircuitEstablishedCmd,
-          base::BindRepeating(&TorControl::GetCircuitEstablishedLine,
-                              weak_ptr_factory_.GetWeakPtr(), established_p),
-          base::BindOnce(&TorControl::GetCircuitEstablishedDone,
-                         weak_ptr_factory_.GetWeakPtr(), std::move(established),
-                         std::move(callback))));
-}
-
-void TorControl::GetCircuitEstablishedLine(std::string* established,
-                                           const std::string& status,
-                                           const std::string& reply) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (status != "250" ||
-      !base::StartsWith(reply, kGetCircuitEstablishedReply,
-                        base::CompareCase::SENSITIVE) ||
-      !established->empty()) {
-    VLOG(0) << "tor: unexpected " << kGetCircuitEstablishedCmd << " reply";
-    return;
-  }
-  *established = reply.substr(strlen(kGetCircuitEstablishedReply));
+      base::BindOnce(&TorControl::DoGetInfo, weak_ptr_factory_.GetWeakPtr(),
+                     kCircuitEstablishedKey,
+                     base::BindOnce(&TorControl::GetCircuitEstablishedDone,
+                                    weak_ptr_factory_.GetWeakPtr(),
+                                    std::move(callback))));
 }
 
 void TorControl::GetCircuitEstablishedDone(
-    std::unique_ptr<std::string> established,
     base::OnceCallback<void(bool error, bool established)> callback,
     bool error,
     const std::string& status,
-    const std::string& reply) {
+    const std::string& reply,
+    const std::vector<std::string>& values) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  bool result;
-  if (*established == "1")
+  bool result = false;
+  if (values.size() != 1)
+    error = true;
+  else if (values[0] == "1")
     result = true;
-  else if (*established == "0")
+  else if (values[0] == "0")
     result = false;
   else
     error = true;
-  if (error || status != "250" || reply != "OK" || established->empty()) {
+  if (error || status != "250" || reply != "OK") {
     std::move(callback).Run(true, false);
     return;
   }
   std::move(callback).Run(false, result);
 }
 
+TorControl::GetInfoBatch::GetInfoBatch() = default;
+TorControl::GetInfoBatch::~GetInfoBatch() = default;
+
 ///////////////////////////////////////////////////////////////////////////////
 // Writing state machine
 
 // StartWrite()
 //
-//      Pick a write off the queue and start an I/O buffer for it.
+//      Take all writes off the queue and start one I/O buffer for
+//      them, so that pipelined commands go out in a single write.
+//      Replies are matched to commands in FIFO order by cmdq_.
 //
 //      Caller must ensure writing_ is true.
 //
@@ -530,9 +545,14 @@ void TorControl::StartWrite() {
   DCHECK(writing_);
   DCHECK(!writeq_.empty());
   DCHECK(!cmdq_.empty());
-  auto buf = base::MakeRefCounted<net::StringIOBuffer>(writeq_.front());
-  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
+  std::string data = std::move(writeq_.front());
   writeq_.pop();
+  while (!writeq_.empty()) {
+    data += writeq_.front();
+    writeq_.pop();
+  }
+  auto buf = base::MakeRefCounted<net::StringIOBuffer>(std::move(data));
+  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
 }
 
 // DoWrites()
@@ -697,7 +717,10 @@ void TorControl::ReadDone(int rv) {
     Error();
     return;
   }
-  const char* data = readiobuf_->data();
+  // Lines are handed to ReadLine() as views into the buffer, so keep it
+  // alive even if a callback tears down the connection.
+  scoped_refptr<net::GrowableIOBuffer> buffer = readiobuf_;
+  const char* data = buffer->data();
   for (int i = 0; i < rv; i++) {
     if (!read_cr_) {
       // No CR yet.  Accept CR or non-LF; reject LF.
@@ -716,14 +739,16 @@ void TorControl::ReadDone(int rv) {
         // CRLF seen, so we must have i >= 2.  Emit a line and advance
         // to the next one, unless anything went wrong with the line.
         assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
-        read_start_ = readiobuf_->offset() + i + 1;
+        base::StringPiece line(buffer->StartOfBuffer() + read_start_,
+                               buffer->offset() + i - 1 - read_start_);
+        read_start_ = buffer->offset() + i + 1;
         read_cr_ = false;
         if (!ReadLine(line)) {
           reading_ = false;
           return;
         }
+        if (!reading_)
+          return;
       } else {
         // CR seen, but not LF.  Bad.
         VLOG(1) << "tor: stray carriage return";
@@ -773,7 +798,7 @@ void TorControl::ReadDone(int rv) {
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -788,9 +813,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -801,8 +826,8 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -815,7 +840,8 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           if (found == kTorControlEventByName.end()) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
@@ -830,7 +856,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, std::string(initial), {});
 
           return true;
         }
@@ -839,13 +865,14 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Start a fresh async reply state.  Parse the rest, but
           // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           const TorControlEvent event =
               (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = std::string(initial);
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -917,7 +944,7 @@ bool TorControl::ReadLine(const std::string& line) {
         NotifyTorRawMid(status, reply);
         if (!cmdq_.empty()) {
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(std::string(status), std::string(reply));
         }
         return true;
       case '+':
@@ -927,10 +954,11 @@ bool TorControl::ReadLine(const std::string& line) {
       case ' ':
         NotifyTorRawEnd(status, reply);
         if (!cmdq_.empty()) {
-          CmdCallback& callback = cmdq_.front().second;
-          bool error = false;
-          std::move(callback).Run(error, status, reply);
+          CmdCallback callback = std::move(cmdq_.front().second);
           cmdq_.pop();
+          bool error = false;
+          std::move(callback).Run(error, std::string(status),
+                                  std::string(reply));
         }
         return true;
     }
@@ -1007,28 +1035,28 @@ void TorControl::NotifyTorRawCmd(const std::string& cmd) {
       FROM_HERE, base::BindOnce(&Delegate::OnTorRawCmd, delegate_, cmd));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawAsync, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawAsync, delegate_,
+                                std::string(status), std::string(line)));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawMid, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawMid, delegate_,
+                                std::string(status), std::string(line)));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawEnd, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawEnd, delegate_,
+                                std::string(status), std::string(line)));
 }
 
 // ParseKV(string, key, value)
@@ -1038,7 +1066,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1053,20 +1081,20 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
+    *key = std::string(string.substr(0, eq));
     *value = "";
     *end = string.size();
     return true;
@@ -1076,7 +1104,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1086,19 +1114,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    *key = std::string(string.substr(0, eq));
+    *value = std::string(string.substr(vstart, vend - vstart));
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  *key = std::string(string.substr(0, eq));
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1113,7 +1141,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
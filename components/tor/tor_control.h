@@ -18,6 +18,7 @@
 #include "base/callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -49,6 +50,13 @@ class TorControl {
                                    const std::string& reply)>;
   using CmdCallback = base::OnceCallback<
       void(bool error, const std::string& status, const std::string& reply)>;
+  // Gets the values of one GETINFO key, plus the status and reply of the
+  // final line of the command it was sent with.
+  using GetInfoCallback =
+      base::OnceCallback<void(bool error,
+                              const std::string& status,
+                              const std::string& reply,
+                              const std::vector<std::string>& values)>;
 
   class Delegate : public base::SupportsWeakPtr<Delegate> {
    public:
@@ -100,14 +108,14 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, GetCircuitEstablishedDone);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -121,34 +129,43 @@ class TorControl {
 
   void DoCmd(std::string cmd, PerLineCallback perline, CmdCallback callback);
 
-  void GetVersionLine(std::string* version,
-                      const std::string& status,
-                      const std::string& line);
+  // GETINFO requests made in the same task are sent as a single command.
+  struct GetInfoBatch {
+    GetInfoBatch();
+    ~GetInfoBatch();
+
+    std::map<std::string, std::vector<std::string>> values;
+    std::vector<std::pair<std::string, GetInfoCallback>> callbacks;
+  };
+  void DoGetInfo(const std::string& key, GetInfoCallback callback);
+  void SendGetInfo();
+  void GetInfoLine(GetInfoBatch* batch,
+                   const std::string& status,
+                   const std::string& reply);
+  void GetInfoDone(std::unique_ptr<GetInfoBatch> batch,
+                   bool error,
+                   const std::string& status,
+                   const std::string& reply);
+
   void GetVersionDone(
-      std::unique_ptr<std::string> version,
       base::OnceCallback<void(bool error, const std::string& version)> callback,
       bool error,
       const std::string& status,
-      const std::string& reply);
-  void GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                             const std::string& status,
-                             const std::string& reply);
+      const std::string& reply,
+      const std::vector<std::string>& values);
   void GetSOCKSListenersDone(
-      std::unique_ptr<std::vector<std::string>> listeners,
       base::OnceCallback<
           void(bool error, const std::vector<std::string>& listeners)> callback,
       bool error,
       const std::string& status,
-      const std::string& reply);
-  void GetCircuitEstablishedLine(std::string* established,
-                                 const std::string& status,
-                                 const std::string& reply);
+      const std::string& reply,
+      const std::vector<std::string>& values);
   void GetCircuitEstablishedDone(
-      std::unique_ptr<std::string> established,
       base::OnceCallback<void(bool error, bool established)> callback,
       bool error,
       const std::string& status,
-      const std::string& reply);
+      const std::string& reply,
+      const std::vector<std::string>& values);
 
   void DoSubscribe(TorControlEvent event,
                    base::OnceCallback<void(bool error)> callback);
@@ -174,9 +191,9 @@ class TorControl {
                       const std::string& initial,
                       const std::map<std::string, std::string>& extra);
   void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
 
   void StartWrite();
   void DoWrites();
@@ -187,7 +204,7 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
 
   void Error();
 
@@ -227,6 +244,8 @@ class TorControl {
   };
   std::unique_ptr<Async> async_;
 
+  std::unique_ptr<GetInfoBatch> getinfo_batch_;
+
   base::WeakPtr<TorControl::Delegate> delegate_;
 
   base::WeakPtrFactory<TorControl> weak_ptr_factory_{this};
@@ -5,11 +5,22 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <utility>
+
+#include "base/barrier_closure.h"
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/socket/stream_socket.h"
+#include "net/socket/tcp_server_socket.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -28,6 +39,85 @@ class MockTorControlDelegate : public TorControl::Delegate {
   MOCK_METHOD2(OnTorRawMid, void(const std::string&, const std::string&));
   MOCK_METHOD2(OnTorRawEnd, void(const std::string&, const std::string&));
 };
+
+// Control port on localhost which answers each command line with a canned
+// reply and records the commands it got.
+class FakeTorControlServer {
+ public:
+  explicit FakeTorControlServer(std::map<std::string, std::string> replies)
+      : replies_(std::move(replies)),
+        server_socket_(nullptr, net::NetLogSource()) {}
+
+  // Returns the port to connect to.
+  int Start() {
+    EXPECT_EQ(net::OK,
+              server_socket_.Listen(
+                  net::IPEndPoint(net::IPAddress::IPv4Localhost(), 0), 1));
+    net::IPEndPoint address;
+    EXPECT_EQ(net::OK, server_socket_.GetLocalAddress(&address));
+    int rv = server_socket_.Accept(
+        &socket_, base::BindOnce(&FakeTorControlServer::OnAccepted,
+                                 base::Unretained(this)));
+    if (rv != net::ERR_IO_PENDING)
+      OnAccepted(rv);
+    return address.port();
+  }
+
+  const std::vector<std::string>& commands() const { return commands_; }
+
+ private:
+  void OnAccepted(int rv) {
+    ASSERT_EQ(net::OK, rv);
+    DoRead();
+  }
+
+  void DoRead() {
+    read_buffer_ = base::MakeRefCounted<net::IOBuffer>(4096);
+    int rv = socket_->Read(
+        read_buffer_.get(), 4096,
+        base::BindOnce(&FakeTorControlServer::OnRead, base::Unretained(this)));
+    if (rv != net::ERR_IO_PENDING)
+      OnRead(rv);
+  }
+
+  void OnRead(int rv) {
+    if (rv <= 0)
+      return;
+    input_.append(read_buffer_->data(), rv);
+    std::string output;
+    size_t eol;
+    while ((eol = input_.find("\r\n")) != std::string::npos) {
+      std::string cmd = input_.substr(0, eol);
+      input_.erase(0, eol + 2);
+      commands_.push_back(cmd);
+      auto found = replies_.find(cmd);
+      output += found != replies_.end() ? found->second
+                                        : "510 Unrecognized command\r\n";
+    }
+    if (!output.empty())
+      Write(output);
+    DoRead();
+  }
+
+  void Write(const std::string& data) {
+    auto buffer = base::MakeRefCounted<net::DrainableIOBuffer>(
+        base::MakeRefCounted<net::StringIOBuffer>(data), data.size());
+    // Replies this small are written synchronously over loopback.
+    while (buffer->BytesRemaining() > 0) {
+      int rv = socket_->Write(buffer.get(), buffer->BytesRemaining(),
+                              base::DoNothing(), TRAFFIC_ANNOTATION_FOR_TESTS);
+      ASSERT_GT(rv, 0);
+      buffer->DidConsume(rv);
+    }
+  }
+
+  std::map<std::string, std::string> replies_;
+  net::TCPServerSocket server_socket_;
+  std::unique_ptr<net::StreamSocket> socket_;
+  scoped_refptr<net::IOBuffer> read_buffer_;
+  std::string input_;
+  std::vector<std::string> commands_;
+};
 }  // namespace
 
 TEST(TorControlTest, ParseQuoted) {
@@ -196,11 +286,8 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
   io_task_runner->PostTask(
       FROM_HERE, base::BindOnce(
                      [](std::unique_ptr<TorControl> control) {
-                       std::unique_ptr<std::string> established =
-                           std::make_unique<std::string>("0");
                        bool is_called = false;
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -208,13 +295,11 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           false, "250", "OK");
+                           false, "250", "OK", {"0"});
                        EXPECT_TRUE(is_called);
 
                        is_called = false;
-                       established.reset(new std::string("1"));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -222,14 +307,12 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_TRUE(result);
                                },
                                &is_called),
-                           false, "250", "OK");
+                           false, "250", "OK", {"1"});
                        EXPECT_TRUE(is_called);
 
                        // --- Error cases ---
                        is_called = false;
-                       established.reset(new std::string("iambrave"));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -237,13 +320,11 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           false, "250", "OK");
+                           false, "250", "OK", {"iambrave"});
                        EXPECT_TRUE(is_called);
 
                        is_called = false;
-                       established.reset(new std::string(""));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -251,13 +332,11 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           false, "250", "OK");
+                           false, "250", "OK", {});
                        EXPECT_TRUE(is_called);
 
                        is_called = false;
-                       established.reset(new std::string("1"));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -265,13 +344,11 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           true, "250", "OK");
+                           true, "250", "OK", {"1"});
                        EXPECT_TRUE(is_called);
 
                        is_called = false;
-                       established.reset(new std::string("1"));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -279,13 +356,11 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           false, "500", "OK");
+                           false, "500", "OK", {"1"});
                        EXPECT_TRUE(is_called);
 
                        is_called = false;
-                       established.reset(new std::string("1"));
                        control->GetCircuitEstablishedDone(
-                           std::move(established),
                            base::BindOnce(
                                [](bool* is_called, bool error, bool result) {
                                  *is_called = true;
@@ -293,11 +368,74 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
                                  EXPECT_FALSE(result);
                                },
                                &is_called),
-                           false, "500", "NOT_OK");
+                           false, "500", "NOT_OK", {"1"});
                        EXPECT_TRUE(is_called);
                      },
                      std::move(control)));
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, BatchesStartupQueries) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  const std::string getinfo_cmd =
+      "GETINFO net/listeners/socks status/circuit-established version";
+  FakeTorControlServer server({
+      {"AUTHENTICATE 0102", "250 OK\r\n"},
+      {"TAKEOWNERSHIP", "250 OK\r\n"},
+      {"RESETCONF __OwningControllerProcess", "250 OK\r\n"},
+      {getinfo_cmd,
+       "250-net/listeners/socks=\"127.0.0.1:9050\"\r\n"
+       "250-status/circuit-established=1\r\n"
+       "250-version=0.4.5.9\r\n"
+       "250 OK\r\n"},
+  });
+  const int port = server.Start();
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+
+  base::RunLoop ready_run_loop;
+  EXPECT_CALL(delegate, OnTorControlReady())
+      .WillOnce(testing::Invoke(&ready_run_loop, &base::RunLoop::Quit));
+  control->Start({0x01, 0x02}, port);
+  ready_run_loop.Run();
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(3, run_loop.QuitClosure());
+  control->GetVersion(base::BindLambdaForTesting(
+      [&](bool error, const std::string& version) {
+        EXPECT_FALSE(error);
+        EXPECT_EQ("0.4.5.9", version);
+        barrier.Run();
+      }));
+  control->GetSOCKSListeners(base::BindLambdaForTesting(
+      [&](bool error, const std::vector<std::string>& listeners) {
+        EXPECT_FALSE(error);
+        EXPECT_EQ(std::vector<std::string>({"\"127.0.0.1:9050\""}),
+                  listeners);
+        barrier.Run();
+      }));
+  control->GetCircuitEstablished(
+      base::BindLambdaForTesting([&](bool error, bool established) {
+        EXPECT_FALSE(error);
+        EXPECT_TRUE(established);
+        barrier.Run();
+      }));
+  run_loop.Run();
+
+  // The three queries went out as one command.
+  ASSERT_EQ(4u, server.commands().size());
+  EXPECT_EQ(getinfo_cmd, server.commands().back());
+
+  control->Stop();
+  io_task_runner->DeleteSoon(FROM_HERE, std::move(control));
+  base::RunLoop().RunUntilIdle();
+}
+
 }  // namespace tor
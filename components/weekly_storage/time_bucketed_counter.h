@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_BUCKETED_COUNTER_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_BUCKETED_COUNTER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "base/check_op.h"
+#include "base/time/time.h"
+
+// Fixed-capacity ring of time buckets, newest first. Each bucket holds a value
+// accumulated since |start|. Opening a new bucket when the ring is full drops
+// the oldest one, so memory use never grows past |kBucketCount| entries.
+// Not thread safe.
+template <typename T, size_t kBucketCount>
+class TimeBucketedCounter {
+ public:
+  static_assert(kBucketCount > 0, "At least one bucket is required");
+
+  struct Bucket {
+    base::Time start;
+    T value = T();
+  };
+
+  TimeBucketedCounter() = default;
+  ~TimeBucketedCounter() = default;
+
+  TimeBucketedCounter(const TimeBucketedCounter&) = default;
+  TimeBucketedCounter& operator=(const TimeBucketedCounter&) = default;
+
+  // Makes sure the newest bucket starts at |bucket_start|, opening a new empty
+  // bucket if |bucket_start| is later than the newest one. Returns true if a
+  // bucket was opened.
+  bool AdvanceTo(base::Time bucket_start) {
+    if (!empty() && bucket_start <= newest().start)
+      return false;
+    head_ = (head_ + kBucketCount - 1) % kBucketCount;
+    buckets_[head_] = {bucket_start, T()};
+    size_ = std::min(size_ + 1, kBucketCount);
+    return true;
+  }
+
+  // Appends a bucket older than all existing ones. Used to restore persisted
+  // state in newest-to-oldest order. Returns false if the ring is full.
+  bool AppendOldest(base::Time start, T value) {
+    if (full())
+      return false;
+    buckets_[(head_ + size_) % kBucketCount] = {start, value};
+    ++size_;
+    return true;
+  }
+
+  // Value of the newest bucket. Must not be called when empty.
+  T& current() {
+    DCHECK(!empty());
+    return buckets_[head_].value;
+  }
+
+  const Bucket& newest() const {
+    DCHECK(!empty());
+    return buckets_[head_];
+  }
+
+  // |index| 0 is the newest bucket.
+  const Bucket& at(size_t index) const {
+    DCHECK_LT(index, size_);
+    return buckets_[(head_ + index) % kBucketCount];
+  }
+
+  // Sum of values of all buckets starting after |threshold|.
+  T SumAfter(base::Time threshold) const {
+    T sum = T();
+    for (size_t i = 0; i < size_; ++i) {
+      const Bucket& bucket = at(i);
+      if (bucket.start > threshold)
+        sum += bucket.value;
+    }
+    return sum;
+  }
+
+  // Largest value of all buckets starting after |threshold|, or T() if there
+  // are none.
+  T MaxAfter(base::Time threshold) const {
+    T max = T();
+    for (size_t i = 0; i < size_; ++i) {
+      const Bucket& bucket = at(i);
+      if (bucket.start > threshold && bucket.value > max)
+        max = bucket.value;
+    }
+    return max;
+  }
+
+  void Clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == kBucketCount; }
+  static constexpr size_t capacity() { return kBucketCount; }
+
+ private:
+  std::array<Bucket, kBucketCount> buckets_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_TIME_BUCKETED_COUNTER_H_
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/time_bucketed_counter.h"
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+base::Time Day(int n) {
+  return base::Time::UnixEpoch() + base::TimeDelta::FromDays(n);
+}
+
+}  // namespace
+
+TEST(TimeBucketedCounterTest, StartsEmpty) {
+  TimeBucketedCounter<int, 3> counter;
+  EXPECT_TRUE(counter.empty());
+  EXPECT_EQ(counter.SumAfter(base::Time()), 0);
+  EXPECT_EQ(counter.MaxAfter(base::Time()), 0);
+}
+
+TEST(TimeBucketedCounterTest, AdvanceOpensBucketOnlyForNewerTime) {
+  TimeBucketedCounter<int, 3> counter;
+  EXPECT_TRUE(counter.AdvanceTo(Day(1)));
+  counter.current() += 5;
+  EXPECT_FALSE(counter.AdvanceTo(Day(1)));
+  EXPECT_FALSE(counter.AdvanceTo(Day(0)));
+  counter.current() += 5;
+  EXPECT_EQ(counter.size(), 1u);
+  EXPECT_EQ(counter.newest().value, 10);
+}
+
+TEST(TimeBucketedCounterTest, DropsOldestWhenFull) {
+  TimeBucketedCounter<int, 3> counter;
+  for (int day = 0; day < 5; ++day) {
+    counter.AdvanceTo(Day(day));
+    counter.current() = day + 1;
+  }
+  ASSERT_TRUE(counter.full());
+  EXPECT_EQ(counter.at(0).start, Day(4));
+  EXPECT_EQ(counter.at(2).start, Day(2));
+  EXPECT_EQ(counter.SumAfter(base::Time()), 3 + 4 + 5);
+  EXPECT_EQ(counter.SumAfter(Day(2)), 4 + 5);
+  EXPECT_EQ(counter.MaxAfter(Day(3)), 5);
+}
+
+TEST(TimeBucketedCounterTest, AppendOldestRestoresOrder) {
+  TimeBucketedCounter<int, 2> counter;
+  EXPECT_TRUE(counter.AppendOldest(Day(5), 1));
+  EXPECT_TRUE(counter.AppendOldest(Day(4), 2));
+  EXPECT_FALSE(counter.AppendOldest(Day(3), 3));
+  EXPECT_EQ(counter.newest().start, Day(5));
+  EXPECT_EQ(counter.at(1).value, 2);
+
+  EXPECT_TRUE(counter.AdvanceTo(Day(6)));
+  EXPECT_EQ(counter.size(), 2u);
+  EXPECT_EQ(counter.at(1).start, Day(5));
+}
@@ -5,9 +5,10 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -15,13 +16,19 @@
 #include "components/prefs/scoped_user_pref_update.h"
 
 namespace {
-constexpr size_t kDaysInWeek = 7;
+constexpr int kSaveDelaySeconds = 30;
 }
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
+    : WeeklyStorage(prefs, pref_name, WriteMode::kImmediate) {}
+
+WeeklyStorage::WeeklyStorage(PrefService* prefs,
+                             const char* pref_name,
+                             WriteMode mode)
     : prefs_(prefs),
       pref_name_(pref_name),
-      clock_(std::make_unique<base::DefaultClock>()) {
+      clock_(std::make_unique<base::DefaultClock>()),
+      write_mode_(mode) {
   DCHECK(pref_name);
   if (prefs) {
     Load();
@@ -31,88 +38,95 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
 WeeklyStorage::WeeklyStorage(PrefService* prefs,
                              const char* pref_name,
                              std::unique_ptr<base::Clock> clock)
-    : prefs_(prefs), pref_name_(pref_name), clock_(std::move(clock)) {
+    : WeeklyStorage(prefs,
+                    pref_name,
+                    std::move(clock),
+                    WriteMode::kImmediate) {}
+
+WeeklyStorage::WeeklyStorage(PrefService* prefs,
+                             const char* pref_name,
+                             std::unique_ptr<base::Clock> clock,
+                             WriteMode mode)
+    : prefs_(prefs),
+      pref_name_(pref_name),
+      clock_(std::move(clock)),
+      write_mode_(mode) {
   DCHECK(prefs);
   DCHECK(pref_name);
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
-  FilterToWeek();
-  daily_values_.front().value += delta;
-  Save();
+  const bool day_changed = FilterToWeek();
+  daily_values_.current() += delta;
+  OnValueChanged(day_changed);
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
-  FilterToWeek();
-  DailyValue& today = daily_values_.front();
-  if (today.value < value) {
-    today.value = value;
+  const bool day_changed = FilterToWeek();
+  uint64_t& today = daily_values_.current();
+  if (today < value) {
+    today = value;
+  } else if (!day_changed) {
+    return;
   }
-  Save();
+  OnValueChanged(day_changed);
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  // Check only last continious days.
+  return daily_values_.SumAfter(n_days_ago);
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
-  }
-  return highest_it->value;
+  return daily_values_.MaxAfter(n_days_ago);
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return daily_values_.full();
 }
 
-void WeeklyStorage::FilterToWeek() {
-  base::Time now_midnight = clock_->Now().LocalMidnight();
-  base::Time last_saved_midnight;
-
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+void WeeklyStorage::Flush() {
+  save_timer_.Stop();
+  if (dirty_) {
+    Save();
   }
+}
 
-  if (now_midnight - last_saved_midnight > base::TimeDelta()) {
-    // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
-    }
+bool WeeklyStorage::FilterToWeek() {
+  // Day changed. Since we consider only small incoming intervals, lets just
+  // save it with a new timestamp. The oldest day is dropped once the week is
+  // full.
+  return daily_values_.AdvanceTo(clock_->Now().LocalMidnight());
+}
+
+void WeeklyStorage::OnValueChanged(bool day_changed) {
+  dirty_ = true;
+  // Persist right away unless writes are deferred, when a new day starts, and
+  // when there is no task runner to post the deferred write to (e.g. in some
+  // unit tests).
+  if (write_mode_ == WriteMode::kImmediate || day_changed ||
+      !base::SequencedTaskRunnerHandle::IsSet()) {
+    Flush();
+    return;
+  }
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE,
+                      base::TimeDelta::FromSeconds(kSaveDelaySeconds),
+                      base::BindOnce(&WeeklyStorage::Save,
+                                     base::Unretained(this)));
   }
 }
 
@@ -128,25 +142,25 @@ void WeeklyStorage::Load() {
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (!daily_values_.AppendOldest(
+            base::Time::FromDoubleT(day->GetDouble()),
+            static_cast<uint64_t>(value->GetDouble()))) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
   }
 }
 
 void WeeklyStorage::Save() {
   DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  dirty_ = false;
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->Clear();
-  for (const auto& u : daily_values_) {
+  for (size_t i = 0; i < daily_values_.size(); ++i) {
+    const auto& u = daily_values_.at(i);
     base::DictionaryValue value;
-    value.SetKey("day", base::Value(u.day.ToDoubleT()));
+    value.SetKey("day", base::Value(u.start.ToDoubleT()));
     value.SetDoubleKey("value", u.value);
     list->Append(std::move(value));
   }
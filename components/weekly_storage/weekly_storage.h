@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/weekly_storage/time_bucketed_counter.h"
 
 namespace base {
 class Clock;
@@ -20,16 +21,34 @@ class PrefService;
 // Mostly used by various P3A recorders - allows to track a sum of some
 // values added from time to time via |AddDelta| over a last week.
 // Requires |pref_name| to be already registered.
+// By default every change is written to prefs right away. A single long-lived
+// owner of |pref_name| can use |WriteMode::kDeferred| to keep values in memory
+// and write them lazily instead.
 // Feel free to improve and refactor it - templatize a stored value type,
 // change weekly interval or make a keyed service from it.
 class WeeklyStorage {
  public:
+  enum class WriteMode {
+    // Writes to prefs on every change. Safe for short-lived instances and for
+    // several instances sharing |pref_name|.
+    kImmediate,
+    // Writes after a short delay, on day rollover, on |Flush| and on
+    // destruction. Reads are served from memory, so no other instance may use
+    // |pref_name| while this one is alive.
+    kDeferred,
+  };
+
   WeeklyStorage(PrefService* prefs, const char* pref_name);
+  WeeklyStorage(PrefService* prefs, const char* pref_name, WriteMode mode);
 
   // For tests.
   WeeklyStorage(PrefService* user_prefs,
                 const char* pref_name,
                 std::unique_ptr<base::Clock> clock);
+  WeeklyStorage(PrefService* user_prefs,
+                const char* pref_name,
+                std::unique_ptr<base::Clock> clock,
+                WriteMode mode);
   ~WeeklyStorage();
 
   WeeklyStorage(const WeeklyStorage&) = delete;
@@ -41,20 +60,28 @@ class WeeklyStorage {
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
 
+  // Writes pending changes to prefs immediately.
+  void Flush();
+
  private:
-  struct DailyValue {
-    base::Time day;
-    uint64_t value = 0ull;
-  };
-  void FilterToWeek();
+  static constexpr size_t kDaysInWeek = 7;
+
+  // Returns true if the day changed since the last recorded value.
+  bool FilterToWeek();
   void Load();
   void Save();
+  // Saves right away in |WriteMode::kImmediate| and on day rollover,
+  // otherwise defers the write.
+  void OnValueChanged(bool day_changed);
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
+  const WriteMode write_mode_;
 
-  std::list<DailyValue> daily_values_;
+  TimeBucketedCounter<uint64_t, kDaysInWeek> daily_values_;
+  bool dirty_ = false;
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
@@ -138,3 +139,86 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, SavesEveryChangeByDefault) {
+  state_->AddDelta(1);
+  state_->AddDelta(2);
+
+  // Another instance sharing the pref sees every change right away.
+  WeeklyStorage other(&pref_service_, "brave.weekly_test");
+  EXPECT_EQ(other.GetWeeklySum(), 3u);
+  other.AddDelta(4);
+
+  WeeklyStorage reloaded(&pref_service_, "brave.weekly_test");
+  EXPECT_EQ(reloaded.GetWeeklySum(), 7u);
+}
+
+class WeeklyStorageDeferredSaveTest : public ::testing::Test {
+ public:
+  WeeklyStorageDeferredSaveTest() : clock_(new base::SimpleTestClock) {
+    pref_service_.registry()->RegisterListPref(kPrefName);
+    clock_->SetNow(base::Time::Now());
+    state_ = std::make_unique<WeeklyStorage>(
+        &pref_service_, kPrefName, std::unique_ptr<base::Clock>(clock_),
+        WeeklyStorage::WriteMode::kDeferred);
+  }
+
+ protected:
+  static constexpr char kPrefName[] = "brave.weekly_deferred_test";
+
+  size_t GetSavedDaysCount() {
+    return pref_service_.GetList(kPrefName)->GetList().size();
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::SimpleTestClock* clock_;
+  TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<WeeklyStorage> state_;
+};
+
+constexpr char WeeklyStorageDeferredSaveTest::kPrefName[];
+
+TEST_F(WeeklyStorageDeferredSaveTest, SavesAfterDelay) {
+  state_->AddDelta(1);
+  // The first value opens a new day, which is saved right away.
+  EXPECT_EQ(GetSavedDaysCount(), 1u);
+
+  state_->AddDelta(2);
+  state_->AddDelta(3);
+  EXPECT_EQ(state_->GetWeeklySum(), 6u);
+
+  // Reading back from prefs still sees the first value only.
+  WeeklyStorage stale(&pref_service_, kPrefName);
+  EXPECT_EQ(stale.GetWeeklySum(), 1u);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  WeeklyStorage fresh(&pref_service_, kPrefName);
+  EXPECT_EQ(fresh.GetWeeklySum(), 6u);
+}
+
+TEST_F(WeeklyStorageDeferredSaveTest, SavesOnDayRollover) {
+  state_->AddDelta(1);
+  state_->AddDelta(1);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  state_->AddDelta(1);
+  EXPECT_EQ(GetSavedDaysCount(), 2u);
+
+  WeeklyStorage reloaded(&pref_service_, kPrefName);
+  EXPECT_EQ(reloaded.GetWeeklySum(), 3u);
+}
+
+TEST_F(WeeklyStorageDeferredSaveTest, SavesOnFlushAndDestruction) {
+  state_->AddDelta(1);
+  state_->AddDelta(1);
+  state_->Flush();
+  {
+    WeeklyStorage reloaded(&pref_service_, kPrefName);
+    EXPECT_EQ(reloaded.GetWeeklySum(), 2u);
+  }
+
+  state_->AddDelta(1);
+  state_.reset();
+  WeeklyStorage reloaded(&pref_service_, kPrefName);
+  EXPECT_EQ(reloaded.GetWeeklySum(), 3u);
+}